@@ -346,6 +346,7 @@ src = {
   'src/main.c',
   'src/util.c',
   'src/core/fs.c',
+  'src/core/job.c',
   ('src/core/os_%s.c'):format(target),
   'src/core/spv.c',
   'src/api/api.c',
@@ -399,7 +400,6 @@ src += config.modules.data and 'src/lib/jsmn/*.c' or nil
 src += config.modules.data and 'src/lib/minimp3/*.c' or nil
 src += config.modules.filesystem and 'src/lib/dmon/*.c' or nil
 src += config.modules.math and 'src/lib/noise/*.c' or nil
-src += config.modules.thread and 'src/core/job.c' or nil
 
 -- embed resource files with xxd
 
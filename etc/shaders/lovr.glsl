@@ -155,9 +155,11 @@ layout(location = 14) in vec4 Tangent;
 #endif
 
 #ifdef GL_VERTEX_SHADER
-#define Transform mat4(Draws[DrawID].transform)
-#define NormalMatrix (cofactor3(Draws[DrawID].transform))
-#define PassColor Draws[DrawID].color
+// The high bit of DrawID marks a batch of draws merged into one instanced draw
+#define DrawSlot ((DrawID & 0x80000000u) != 0u ? (DrawID & 0xffu) + uint(InstanceIndex) : DrawID)
+#define Transform mat4(Draws[DrawSlot].transform)
+#define NormalMatrix (cofactor3(Draws[DrawSlot].transform))
+#define PassColor Draws[DrawSlot].color
 #define ClipFromLocal (ViewProjection * Transform)
 #define ClipFromWorld (ViewProjection)
 #define ClipFromView (Projection)
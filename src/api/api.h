@@ -140,7 +140,7 @@ int luax_readmesh(lua_State* L, int index, float** vertices, uint32_t* vertexCou
 struct Blob;
 struct Image;
 struct ModelData;
-struct Blob* luax_readblob(lua_State* L, int index, const char* debug);
+struct Blob* luax_readblob(lua_State* L, int index, const char* debug, bool map);
 struct Image* luax_checkimage(lua_State* L, int index);
 uint32_t luax_checkcodepoint(lua_State* L, int index);
 uint32_t luax_checkanimationindex(lua_State* L, int index, struct ModelData* model);
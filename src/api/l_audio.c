@@ -119,6 +119,16 @@ static int l_lovrAudioIsStarted(lua_State* L) {
   return 1;
 }
 
+static int l_lovrAudioRender(lua_State* L) {
+  Sound* sound = luax_checktype(L, 1, Sound);
+  uint32_t offset = luax_optu32(L, 3, 0);
+  uint32_t frames = lovrSoundIsStream(sound) ? lovrSoundGetCapacity(sound) : lovrSoundGetFrameCount(sound) - MIN(offset, lovrSoundGetFrameCount(sound));
+  frames = luax_optu32(L, 2, frames);
+  uint32_t count = lovrAudioRender(frames, sound, offset);
+  lua_pushinteger(L, count);
+  return 1;
+}
+
 static int l_lovrAudioGetVolume(lua_State* L) {
   VolumeUnit units = luax_checkenum(L, 1, VolumeUnit, "linear");
   lua_pushnumber(L, lovrAudioGetVolume(units));
@@ -217,6 +227,14 @@ static int l_lovrAudioGetSampleRate(lua_State *L) {
   return 1;
 }
 
+static int l_lovrAudioGetVoiceCount(lua_State* L) {
+  uint32_t active, virtual;
+  lovrAudioGetVoiceCount(&active, &virtual);
+  lua_pushinteger(L, active);
+  lua_pushinteger(L, virtual);
+  return 2;
+}
+
 static int l_lovrAudioGetAbsorption(lua_State* L) {
   float absorption[3];
   lovrAudioGetAbsorption(absorption);
@@ -280,7 +298,7 @@ static int l_lovrAudioNewSource(lua_State* L) {
   uint32_t defer = lovrDeferPush();
 
   if (!sound) {
-    Blob* blob = luax_readblob(L, 1, "Source");
+    Blob* blob = luax_readblob(L, 1, "Source", decode);
     lovrDeferRelease(blob, lovrBlobDestroy);
     sound = lovrSoundCreateFromFile(blob, decode);
     lovrDeferRelease(sound, lovrSoundDestroy);
@@ -300,6 +318,7 @@ static const luaL_Reg lovrAudio[] = {
   { "start", l_lovrAudioStart },
   { "stop", l_lovrAudioStop },
   { "isStarted", l_lovrAudioIsStarted },
+  { "render", l_lovrAudioRender },
   { "getVolume", l_lovrAudioGetVolume },
   { "setVolume", l_lovrAudioSetVolume },
   { "getPosition", l_lovrAudioGetPosition },
@@ -311,6 +330,7 @@ static const luaL_Reg lovrAudio[] = {
   { "setGeometry", l_lovrAudioSetGeometry },
   { "getSpatializer", l_lovrAudioGetSpatializer },
   { "getSampleRate", l_lovrAudioGetSampleRate },
+  { "getVoiceCount", l_lovrAudioGetVoiceCount },
   { "getAbsorption", l_lovrAudioGetAbsorption },
   { "setAbsorption", l_lovrAudioSetAbsorption },
   { "newSource", l_lovrAudioNewSource },
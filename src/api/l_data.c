@@ -63,7 +63,7 @@ Image* luax_checkimage(lua_State* L, int index) {
   if (image) {
     lovrRetain(image);
   } else {
-    Blob* blob = luax_readblob(L, index, "Image");
+    Blob* blob = luax_readblob(L, index, "Image", true);
     uint32_t defer = lovrDeferPush();
     lovrDeferRelease(blob, lovrBlobDestroy);
     image = lovrImageCreateFromFile(blob);
@@ -125,7 +125,7 @@ static int l_lovrDataNewImage(lua_State* L) {
       image = lovrImageCreateRaw(width, height, format, true);
       memcpy(lovrImageGetLayerData(image, 0, 0), lovrImageGetLayerData(source, 0, 0), lovrImageGetLayerSize(image, 0));
     } else {
-      Blob* blob = luax_readblob(L, 1, "Texture");
+      Blob* blob = luax_readblob(L, 1, "Texture", false);
       image = lovrImageCreateFromFile(blob);
       lovrRelease(blob, lovrBlobDestroy);
     }
@@ -137,7 +137,7 @@ static int l_lovrDataNewImage(lua_State* L) {
 }
 
 static int l_lovrDataNewModelData(lua_State* L) {
-  Blob* blob = luax_readblob(L, 1, "Model");
+  Blob* blob = luax_readblob(L, 1, "Model", false);
   uint32_t defer = lovrDeferPush();
   lovrDeferRelease(blob, lovrBlobDestroy);
   ModelData* modelData = lovrModelDataCreate(blob, luax_readfile);
@@ -156,7 +156,7 @@ static int l_lovrDataNewRasterizer(lua_State* L) {
   if (lua_type(L, 1) == LUA_TNUMBER || lua_isnoneornil(L, 1)) {
     size = luax_optfloat(L, 1, 32.f);
   } else {
-    blob = luax_readblob(L, 1, "Font");
+    blob = luax_readblob(L, 1, "Font", false);
     size = luax_optfloat(L, 2, 32.f);
     lovrDeferRelease(blob, lovrBlobDestroy);
   }
@@ -189,8 +189,9 @@ static int l_lovrDataNewSound(lua_State* L) {
     return luax_typeerror(L, 1, "number, string, or Blob");
   }
 
-  Blob* blob = luax_readblob(L, 1, "Sound");
+  // Streaming Sounds keep reading from the Blob, only decoded ones can use a mapped file
   bool decode = lua_toboolean(L, 2);
+  Blob* blob = luax_readblob(L, 1, "Sound", decode);
 
   uint32_t defer = lovrDeferPush();
   lovrDeferRelease(blob, lovrBlobDestroy);
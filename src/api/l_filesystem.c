@@ -28,8 +28,9 @@ bool luax_writefile(const char* filename, const void* data, size_t size) {
   return lovrFilesystemWrite(filename, data, size, false);
 }
 
-// Returns a Blob, leaving stack unchanged.  The Blob must be released when finished.
-Blob* luax_readblob(lua_State* L, int index, const char* debug) {
+// Returns a Blob, leaving stack unchanged.  The Blob must be released when finished.  Files are
+// only mapped if map is true, which callers should only do when the Blob won't outlive the call.
+Blob* luax_readblob(lua_State* L, int index, const char* debug, bool map) {
   if (lua_type(L, index) == LUA_TUSERDATA) {
     Blob* blob = luax_checktype(L, index, Blob);
     lovrRetain(blob);
@@ -37,6 +38,14 @@ Blob* luax_readblob(lua_State* L, int index, const char* debug) {
   } else {
     const char* path = luaL_checkstring(L, index);
 
+    if (map) {
+      Blob* blob = lovrFilesystemMap(path);
+      if (!blob) {
+        luaL_error(L, "Could not read %s from '%s'", debug, path);
+      }
+      return blob;
+    }
+
     size_t size;
     void* data = luax_readfile(path, &size);
     if (!data) {
@@ -207,6 +216,19 @@ static int l_lovrFilesystemGetLastModified(lua_State* L) {
   return 1;
 }
 
+static int l_lovrFilesystemGetMountTime(lua_State* L) {
+  const char* path = luaL_checkstring(L, 1);
+  double time = lovrFilesystemGetMountTime(path);
+
+  if (time < 0.) {
+    lua_pushnil(L);
+  } else {
+    lua_pushnumber(L, time);
+  }
+
+  return 1;
+}
+
 static int l_lovrFilesystemGetRealDirectory(lua_State* L) {
   const char* path = luaL_checkstring(L, 1);
   lua_pushstring(L, lovrFilesystemGetRealDirectory(path));
@@ -410,6 +432,7 @@ static const luaL_Reg lovrFilesystem[] = {
   { "getExecutablePath", l_lovrFilesystemGetExecutablePath },
   { "getIdentity", l_lovrFilesystemGetIdentity },
   { "getLastModified", l_lovrFilesystemGetLastModified },
+  { "getMountTime", l_lovrFilesystemGetMountTime },
   { "getRealDirectory", l_lovrFilesystemGetRealDirectory },
   { "getRequirePath", l_lovrFilesystemGetRequirePath },
   { "getSaveDirectory", l_lovrFilesystemGetSaveDirectory },
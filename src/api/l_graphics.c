@@ -302,20 +302,29 @@ uint32_t luax_checkcomparemode(lua_State* L, int index) {
 
 static void luax_writeshadercache(void) {
   size_t size;
+  void* data;
+
   lovrGraphicsGetShaderCache(NULL, &size);
 
-  if (size == 0) {
-    return;
-  }
+  if (size > 0) {
+    data = lovrMalloc(size);
+    lovrGraphicsGetShaderCache(data, &size);
 
-  void* data = lovrMalloc(size);
-  lovrGraphicsGetShaderCache(data, &size);
+    if (size > 0) {
+      luax_writefile(".lovrshadercache", data, size);
+    }
 
-  if (size > 0) {
-    luax_writefile(".lovrshadercache", data, size);
+    lovrFree(data);
   }
 
-  lovrFree(data);
+  // The loaded cache is still on disk unless a shader had to be compiled
+  if (lovrGraphicsIsSpirvCacheDirty()) {
+    lovrGraphicsGetSpirvCache(NULL, &size);
+    data = lovrMalloc(size);
+    lovrGraphicsGetSpirvCache(data, &size);
+    luax_writefile(".lovrspirvcache", data, size);
+    lovrFree(data);
+  }
 }
 
 static int l_lovrGraphicsInitialize(lua_State* L) {
@@ -358,6 +367,8 @@ static int l_lovrGraphicsInitialize(lua_State* L) {
   if (shaderCache) {
     config.cacheData = luax_readfile(".lovrshadercache", &config.cacheSize);
     lovrDefer(lovrFree, config.cacheData);
+    config.spirvCacheData = luax_readfile(".lovrspirvcache", &config.spirvCacheSize);
+    lovrDefer(lovrFree, config.spirvCacheData);
   }
 
   lovrGraphicsInit(&config);
@@ -390,16 +401,14 @@ static int l_lovrGraphicsSetTimingEnabled(lua_State* L) {
   return 0;
 }
 
-static int l_lovrGraphicsSubmit(lua_State* L) {
+// Reads a list of Passes, either as varargs or a table, using the stack array if it's big enough
+static Pass** luax_checkpasses(lua_State* L, Pass** stack, uint32_t capacity, uint32_t* count) {
   bool table = lua_istable(L, 1);
   int length = table ? luax_len(L, 1) : lua_gettop(L);
-  uint32_t count = 0;
-
-  Pass* stack[8];
   Pass** passes = stack;
-  uint32_t defer = lovrDeferPush();
+  *count = 0;
 
-  if ((size_t) length > COUNTOF(stack)) {
+  if ((size_t) length > capacity) {
     passes = lovrMalloc(length * sizeof(Pass*));
     lovrDefer(lovrFree, passes);
   }
@@ -408,24 +417,76 @@ static int l_lovrGraphicsSubmit(lua_State* L) {
     for (int i = 0; i < length; i++) {
       lua_rawgeti(L, 1, i + 1);
       if (lua_toboolean(L, -1)) {
-        passes[count++] = luax_checktype(L, -1, Pass);
+        passes[(*count)++] = luax_checktype(L, -1, Pass);
       }
       lua_pop(L, 1);
     }
   } else {
     for (int i = 0; i < length; i++) {
       if (lua_toboolean(L, i + 1)) {
-        passes[count++] = luax_checktype(L, i + 1, Pass);
+        passes[(*count)++] = luax_checktype(L, i + 1, Pass);
       }
     }
   }
 
+  return passes;
+}
+
+static int l_lovrGraphicsSubmit(lua_State* L) {
+  Pass* stack[8];
+  uint32_t count;
+  uint32_t defer = lovrDeferPush();
+  Pass** passes = luax_checkpasses(L, stack, COUNTOF(stack), &count);
   lovrGraphicsSubmit(passes, count);
   lua_pushboolean(L, true);
   lovrDeferPop(defer);
   return 1;
 }
 
+static int l_lovrGraphicsPrewarm(lua_State* L) {
+  Pass* stack[8];
+  uint32_t count;
+  uint32_t defer = lovrDeferPush();
+  Pass** passes = luax_checkpasses(L, stack, COUNTOF(stack), &count);
+  lovrGraphicsPrewarm(passes, count);
+  lovrDeferPop(defer);
+  return 0;
+}
+
+static int l_lovrGraphicsIsPrewarming(lua_State* L) {
+  lua_pushboolean(L, lovrGraphicsIsPrewarming());
+  return 1;
+}
+
+static int l_lovrGraphicsAnimateModels(lua_State* L) {
+  luaL_checktype(L, 1, LUA_TTABLE);
+  uint32_t count = luax_len(L, 1);
+  bool animations = lua_istable(L, 2);
+  bool times = lua_istable(L, 3);
+  bool alphas = lua_istable(L, 4);
+
+  uint32_t defer = lovrDeferPush();
+  AnimateInfo* infos = lovrMalloc(count * sizeof(AnimateInfo));
+  lovrDefer(lovrFree, infos);
+
+  for (uint32_t i = 0; i < count; i++) {
+    lua_rawgeti(L, 1, i + 1);
+    Model* model = luax_checktype(L, -1, Model);
+    if (animations) lua_rawgeti(L, 2, i + 1); else lua_pushvalue(L, 2);
+    if (times) lua_rawgeti(L, 3, i + 1); else lua_pushvalue(L, 3);
+    if (alphas) lua_rawgeti(L, 4, i + 1); else lua_pushvalue(L, 4);
+    infos[i].model = model;
+    infos[i].animation = luax_checkanimationindex(L, -3, lovrModelGetInfo(model)->data);
+    infos[i].time = luax_checkfloat(L, -2);
+    infos[i].alpha = luax_optfloat(L, -1, 1.f);
+    lua_pop(L, 4);
+  }
+
+  lovrGraphicsAnimateModels(infos, count);
+  lovrDeferPop(defer);
+  return 0;
+}
+
 static int l_lovrGraphicsPresent(lua_State* L) {
   lovrGraphicsPresent();
   return 0;
@@ -535,6 +596,17 @@ static int l_lovrGraphicsIsFormatSupported(lua_State* L) {
   return 2;
 }
 
+static int l_lovrGraphicsGetSpirvCache(lua_State* L) {
+  size_t size;
+  lovrGraphicsGetSpirvCache(NULL, &size);
+  void* data = lovrMalloc(size);
+  lovrGraphicsGetSpirvCache(data, &size);
+  Blob* blob = lovrBlobCreate(data, size, "SPIR-V cache");
+  luax_pushtype(L, Blob, blob);
+  lovrRelease(blob, lovrBlobDestroy);
+  return 1;
+}
+
 static int l_lovrGraphicsGetBackgroundColor(lua_State* L) {
   float color[4];
   lovrGraphicsGetBackgroundColor(color);
@@ -1103,7 +1175,20 @@ static int l_lovrGraphicsNewShader(lua_State* L) {
     index = 3;
   }
 
-  lovrGraphicsCompileShader(source, compiled, info.stageCount, luax_readfile);
+  bool async = false;
+
+  if (lua_istable(L, index)) {
+    lua_getfield(L, index, "async");
+    async = lua_toboolean(L, -1);
+    lua_pop(L, 1);
+  }
+
+  // Async shaders are compiled from the source on a worker thread
+  if (async) {
+    memcpy(compiled, source, sizeof(source));
+  } else {
+    lovrGraphicsCompileShader(source, compiled, info.stageCount, luax_readfile);
+  }
 
   arr_t(ShaderFlag) flags;
   arr_init(&flags);
@@ -1141,7 +1226,7 @@ static int l_lovrGraphicsNewShader(lua_State* L) {
   info.flags = flags.data;
   info.flagCount = (uint32_t) flags.length;
 
-  Shader* shader = lovrShaderCreate(&info);
+  Shader* shader = async ? lovrShaderCreateAsync(&info, luax_readfile) : lovrShaderCreate(&info);
   luax_pushtype(L, Shader, shader);
   lovrRelease(shader, lovrShaderDestroy);
 
@@ -1319,7 +1404,7 @@ static int l_lovrGraphicsNewFont(lua_State* L) {
       size = luax_optfloat(L, 1, 32.);
       info.spread = luaL_optnumber(L, 2, info.spread);
     } else {
-      blob = luax_readblob(L, 1, "Font");
+      blob = luax_readblob(L, 1, "Font", false);
       size = luax_optfloat(L, 2, 32.);
       info.spread = luaL_optnumber(L, 3, info.spread);
       lovrDeferRelease(blob, lovrBlobDestroy);
@@ -1448,14 +1533,7 @@ static int l_lovrGraphicsNewModel(lua_State* L) {
   info.materials = true;
   info.mipmaps = true;
 
-  uint32_t defer = lovrDeferPush();
-
-  if (!info.data) {
-    Blob* blob = luax_readblob(L, 1, "Model");
-    lovrDeferRelease(blob, lovrBlobDestroy);
-    info.data = lovrModelDataCreate(blob, luax_readfile);
-    lovrDeferRelease(info.data, lovrModelDataDestroy);
-  }
+  bool async = false;
 
   if (lua_istable(L, 2)) {
     lua_getfield(L, 2, "mipmaps");
@@ -1465,15 +1543,42 @@ static int l_lovrGraphicsNewModel(lua_State* L) {
     lua_getfield(L, 2, "materials");
     info.materials = lua_isnil(L, -1) || lua_toboolean(L, -1);
     lua_pop(L, 1);
+
+    lua_getfield(L, 2, "async");
+    async = lua_toboolean(L, -1);
+    lua_pop(L, 1);
+  }
+
+  uint32_t defer = lovrDeferPush();
+  Blob* blob = NULL;
+
+  if (!info.data) {
+    blob = luax_readblob(L, 1, "Model", false);
+    lovrDeferRelease(blob, lovrBlobDestroy);
   }
 
-  Model* model = lovrModelCreate(&info);
+  // Async models decode their data on a worker thread, ModelData objects are already decoded
+  if (blob && !async) {
+    info.data = lovrModelDataCreate(blob, luax_readfile);
+    lovrDeferRelease(info.data, lovrModelDataDestroy);
+  }
+
+  Model* model = blob && async ? lovrModelCreateAsync(&info, blob, luax_readfile) : lovrModelCreate(&info);
   luax_pushtype(L, Model, model);
   lovrRelease(model, lovrModelDestroy);
   lovrDeferPop(defer);
   return 1;
 }
 
+static int l_lovrGraphicsNewPose(lua_State* L) {
+  ModelData* data = luax_totype(L, 1, ModelData);
+  if (!data) data = lovrModelGetInfo(luax_checktype(L, 1, Model))->data;
+  Pose* pose = lovrPoseCreate(data);
+  luax_pushtype(L, Pose, pose);
+  lovrRelease(pose, lovrPoseDestroy);
+  return 1;
+}
+
 int l_lovrPassSetCanvas(lua_State* L);
 
 static int l_lovrGraphicsNewPass(lua_State* L) {
@@ -1494,10 +1599,14 @@ static const luaL_Reg lovrGraphics[] = {
   { "submit", l_lovrGraphicsSubmit },
   { "present", l_lovrGraphicsPresent },
   { "wait", l_lovrGraphicsWait },
+  { "prewarm", l_lovrGraphicsPrewarm },
+  { "isPrewarming", l_lovrGraphicsIsPrewarming },
+  { "animateModels", l_lovrGraphicsAnimateModels },
   { "getDevice", l_lovrGraphicsGetDevice },
   { "getFeatures", l_lovrGraphicsGetFeatures },
   { "getLimits", l_lovrGraphicsGetLimits },
   { "isFormatSupported", l_lovrGraphicsIsFormatSupported },
+  { "getSpirvCache", l_lovrGraphicsGetSpirvCache },
   { "getBackgroundColor", l_lovrGraphicsGetBackgroundColor },
   { "setBackgroundColor", l_lovrGraphicsSetBackgroundColor },
   { "getWindowPass", l_lovrGraphicsGetWindowPass },
@@ -1512,6 +1621,7 @@ static const luaL_Reg lovrGraphics[] = {
   { "newFont", l_lovrGraphicsNewFont },
   { "newMesh", l_lovrGraphicsNewMesh },
   { "newModel", l_lovrGraphicsNewModel },
+  { "newPose", l_lovrGraphicsNewPose },
   { "newPass", l_lovrGraphicsNewPass },
   { NULL, NULL }
 };
@@ -1524,6 +1634,7 @@ extern const luaL_Reg lovrMaterial[];
 extern const luaL_Reg lovrFont[];
 extern const luaL_Reg lovrMesh[];
 extern const luaL_Reg lovrModel[];
+extern const luaL_Reg lovrPose[];
 extern const luaL_Reg lovrReadback[];
 extern const luaL_Reg lovrPass[];
 
@@ -1538,6 +1649,7 @@ int luaopen_lovr_graphics(lua_State* L) {
   luax_registertype(L, Font);
   luax_registertype(L, Mesh);
   luax_registertype(L, Model);
+  luax_registertype(L, Pose);
   luax_registertype(L, Readback);
   luax_registertype(L, Pass);
   return 1;
@@ -1,5 +1,6 @@
 #include "api.h"
 #include "graphics/graphics.h"
+#include "data/blob.h"
 #include "data/rasterizer.h"
 #include "util.h"
 #include <stdlib.h>
@@ -60,6 +61,56 @@ static int l_lovrFontSetLineSpacing(lua_State* L) {
   return 0;
 }
 
+static int l_lovrFontPreload(lua_State* L) {
+  Font* font = luax_checktype(L, 1, Font);
+  int top = lua_gettop(L);
+
+  // A string never has more codepoints than bytes
+  size_t capacity = 0;
+  for (int i = 2; i <= top; i++) {
+    capacity += lua_type(L, i) == LUA_TSTRING ? luax_len(L, i) : 1;
+  }
+
+  uint32_t defer = lovrDeferPush();
+  uint32_t* codepoints = lovrMalloc(MAX(capacity, 1) * sizeof(uint32_t));
+  lovrDefer(lovrFree, codepoints);
+  uint32_t count = 0;
+
+  for (int i = 2; i <= top; i++) {
+    if (lua_type(L, i) == LUA_TSTRING) {
+      size_t length, bytes;
+      const char* str = lua_tolstring(L, i, &length);
+      const char* end = str + length;
+      while ((bytes = utf8_decode(str, end, &codepoints[count])) > 0) {
+        str += bytes;
+        count++;
+      }
+    } else {
+      codepoints[count++] = luax_checkcodepoint(L, i);
+    }
+  }
+
+  lovrFontPreload(font, codepoints, count);
+  lovrDeferPop(defer);
+  return 0;
+}
+
+static int l_lovrFontGetAtlasCache(lua_State* L) {
+  Font* font = luax_checktype(L, 1, Font);
+  Blob* blob = lovrFontGetAtlasCache(font);
+  luax_pushtype(L, Blob, blob);
+  lovrRelease(blob, lovrBlobDestroy);
+  return 1;
+}
+
+static int l_lovrFontSetAtlasCache(lua_State* L) {
+  Font* font = luax_checktype(L, 1, Font);
+  Blob* blob = luax_checktype(L, 2, Blob);
+  bool loaded = lovrFontSetAtlasCache(font, blob);
+  lua_pushboolean(L, loaded);
+  return 1;
+}
+
 static int l_lovrFontGetAscent(lua_State* L) {
   Font* font = luax_checktype(L, 1, Font);
   const FontInfo* info = lovrFontGetInfo(font);
@@ -140,9 +191,9 @@ static int l_lovrFontGetVertices(lua_State* L) {
     totalLength += strings[i].length;
   }
   GlyphVertex* vertices = lovrMalloc(totalLength * 4 * sizeof(GlyphVertex));
-  uint32_t glyphCount, lineCount;
-  Material* material;
-  lovrFontGetVertices(font, strings, count, wrap, halign, valign, vertices, &glyphCount, &lineCount, &material, false);
+  uint32_t glyphCount, lineCount, batchCount;
+  GlyphBatch batches[MAX_FONT_PAGES];
+  lovrFontGetVertices(font, strings, count, wrap, halign, valign, vertices, &glyphCount, &lineCount, batches, &batchCount, false);
   int vertexCount = glyphCount * 4;
   lua_createtable(L, vertexCount, 0);
   for (int i = 0; i < vertexCount; i++) {
@@ -157,10 +208,23 @@ static int l_lovrFontGetVertices(lua_State* L) {
     lua_rawseti(L, -2, 4);
     lua_rawseti(L, -2, i + 1);
   }
-  luax_pushtype(L, Material, material);
+  // Text that spans multiple atlas pages needs a draw per page, the batches say which vertices go
+  // with each Material.  The second return value stays the Material of the first batch.
+  luax_pushtype(L, Material, batchCount > 0 ? batches[0].material : NULL);
+  lua_createtable(L, batchCount, 0);
+  for (uint32_t i = 0; i < batchCount; i++) {
+    lua_createtable(L, 0, 3);
+    luax_pushtype(L, Material, batches[i].material);
+    lua_setfield(L, -2, "material");
+    lua_pushinteger(L, batches[i].start * 4 + 1);
+    lua_setfield(L, -2, "start");
+    lua_pushinteger(L, batches[i].count * 4);
+    lua_setfield(L, -2, "count");
+    lua_rawseti(L, -2, i + 1);
+  }
   if (strings != &stack) lovrFree(strings);
   lovrFree(vertices);
-  return 2;
+  return 3;
 }
 
 const luaL_Reg lovrFont[] = {
@@ -169,6 +233,9 @@ const luaL_Reg lovrFont[] = {
   { "setPixelDensity", l_lovrFontSetPixelDensity },
   { "getLineSpacing", l_lovrFontGetLineSpacing },
   { "setLineSpacing", l_lovrFontSetLineSpacing },
+  { "preload", l_lovrFontPreload },
+  { "getAtlasCache", l_lovrFontGetAtlasCache },
+  { "setAtlasCache", l_lovrFontSetAtlasCache },
   { "getAscent", l_lovrFontGetAscent },
   { "getDescent", l_lovrFontGetDescent },
   { "getHeight", l_lovrFontGetHeight },
@@ -46,6 +46,12 @@ static int l_lovrModelClone(lua_State* L) {
   return 1;
 }
 
+static int l_lovrModelIsComplete(lua_State* L) {
+  Model* model = luax_checktype(L, 1, Model);
+  lua_pushboolean(L, lovrModelIsComplete(model));
+  return 1;
+}
+
 static int l_lovrModelGetData(lua_State* L) {
   Model* model = luax_checktype(L, 1, Model);
   ModelData* data = lovrModelGetInfo(model)->data;
@@ -250,6 +256,33 @@ static int l_lovrModelAnimate(lua_State* L) {
   return 0;
 }
 
+static int l_lovrModelGetAnimationInterval(lua_State* L) {
+  Model* model = luax_checktype(L, 1, Model);
+  lua_pushinteger(L, lovrModelGetAnimationInterval(model));
+  return 1;
+}
+
+static int l_lovrModelSetAnimationInterval(lua_State* L) {
+  Model* model = luax_checktype(L, 1, Model);
+  uint32_t interval = luax_checku32(L, 2);
+  lovrModelSetAnimationInterval(model, interval);
+  return 0;
+}
+
+static int l_lovrModelGetPose(lua_State* L) {
+  Model* model = luax_checktype(L, 1, Model);
+  Pose* pose = luax_checktype(L, 2, Pose);
+  lovrModelGetPose(model, pose);
+  return 0;
+}
+
+static int l_lovrModelSetPose(lua_State* L) {
+  Model* model = luax_checktype(L, 1, Model);
+  Pose* pose = luax_checktype(L, 2, Pose);
+  lovrModelSetPose(model, pose);
+  return 0;
+}
+
 static int l_lovrModelGetBlendShapeCount(lua_State* L) {
   return luax_callmodeldata(L, "getBlendShapeCount", 1);
 }
@@ -376,6 +409,7 @@ static int l_lovrModelGetMaterial(lua_State* L) {
 
 const luaL_Reg lovrModel[] = {
   { "clone", l_lovrModelClone },
+  { "isComplete", l_lovrModelIsComplete },
   { "getData", l_lovrModelGetData },
   { "getMetadata", l_lovrModelGetMetadata },
   { "getRootNode", l_lovrModelGetRootNode },
@@ -399,6 +433,10 @@ const luaL_Reg lovrModel[] = {
   { "getAnimationDuration", l_lovrModelGetAnimationDuration },
   { "hasJoints", l_lovrModelHasJoints },
   { "animate", l_lovrModelAnimate },
+  { "getAnimationInterval", l_lovrModelGetAnimationInterval },
+  { "setAnimationInterval", l_lovrModelSetAnimationInterval },
+  { "getPose", l_lovrModelGetPose },
+  { "setPose", l_lovrModelSetPose },
   { "getBlendShapeCount", l_lovrModelGetBlendShapeCount },
   { "getBlendShapeName", l_lovrModelGetBlendShapeName },
   { "getBlendShapeWeight", l_lovrModelGetBlendShapeWeight },
@@ -20,6 +20,13 @@ static int l_lovrPassGetStats(lua_State* L) {
   lua_pushinteger(L, stats->draws), lua_setfield(L, -2, "draws");
   lua_pushinteger(L, stats->computes), lua_setfield(L, -2, "computes");
   lua_pushinteger(L, stats->drawsCulled), lua_setfield(L, -2, "drawsCulled");
+  lua_pushinteger(L, stats->pipelineBinds), lua_setfield(L, -2, "pipelineBinds");
+  lua_pushinteger(L, stats->bundleBinds), lua_setfield(L, -2, "bundleBinds");
+  lua_pushinteger(L, stats->drawCalls), lua_setfield(L, -2, "drawCalls");
+  lua_pushinteger(L, stats->pipelineWaits), lua_setfield(L, -2, "pipelineWaits");
+  lua_pushinteger(L, stats->pipelinesCreated), lua_setfield(L, -2, "pipelinesCreated");
+  lua_pushinteger(L, stats->textCacheHits), lua_setfield(L, -2, "textCacheHits");
+  lua_pushinteger(L, stats->textCacheMisses), lua_setfield(L, -2, "textCacheMisses");
   lua_pushinteger(L, stats->cpuMemoryReserved), lua_setfield(L, -2, "cpuMemoryReserved");
   lua_pushinteger(L, stats->cpuMemoryUsed), lua_setfield(L, -2, "cpuMemoryUsed");
   lua_pushnumber(L, stats->submitTime), lua_setfield(L, -2, "submitTime");
@@ -27,6 +34,32 @@ static int l_lovrPassGetStats(lua_State* L) {
   return 1;
 }
 
+static int l_lovrPassGetSorting(lua_State* L) {
+  Pass* pass = luax_checktype(L, 1, Pass);
+  lua_pushboolean(L, lovrPassGetSorting(pass));
+  return 1;
+}
+
+static int l_lovrPassSetSorting(lua_State* L) {
+  Pass* pass = luax_checktype(L, 1, Pass);
+  bool sort = lua_toboolean(L, 2);
+  lovrPassSetSorting(pass, sort);
+  return 0;
+}
+
+static int l_lovrPassGetBatching(lua_State* L) {
+  Pass* pass = luax_checktype(L, 1, Pass);
+  lua_pushboolean(L, lovrPassGetBatching(pass));
+  return 1;
+}
+
+static int l_lovrPassSetBatching(lua_State* L) {
+  Pass* pass = luax_checktype(L, 1, Pass);
+  bool batch = lua_toboolean(L, 2);
+  lovrPassSetBatching(pass, batch);
+  return 0;
+}
+
 static int l_lovrPassGetCanvas(lua_State* L) {
   Pass* pass = luax_checktype(L, 1, Pass);
   Texture* textures[4];
@@ -1064,6 +1097,10 @@ static int l_lovrPassBarrier(lua_State* L) {
 const luaL_Reg lovrPass[] = {
   { "reset", l_lovrPassReset },
   { "getStats", l_lovrPassGetStats },
+  { "getSorting", l_lovrPassGetSorting },
+  { "setSorting", l_lovrPassSetSorting },
+  { "getBatching", l_lovrPassGetBatching },
+  { "setBatching", l_lovrPassSetBatching },
 
   { "getCanvas", l_lovrPassGetCanvas },
   { "setCanvas", l_lovrPassSetCanvas },
@@ -0,0 +1,93 @@
+#include "api.h"
+#include "graphics/graphics.h"
+#include "data/modelData.h"
+#include "util.h"
+
+// Reads an optional table of node names/indices, using the stack array if it's big enough
+static uint32_t* luax_checknodemask(lua_State* L, int index, ModelData* data, uint32_t* stack, uint32_t capacity, uint32_t* count) {
+  if (lua_isnoneornil(L, index)) {
+    *count = 0;
+    return NULL;
+  }
+
+  luaL_checktype(L, index, LUA_TTABLE);
+  uint32_t length = luax_len(L, index);
+  uint32_t* nodes = stack;
+
+  if (length > capacity) {
+    nodes = lovrMalloc(length * sizeof(uint32_t));
+    lovrDefer(lovrFree, nodes);
+  }
+
+  for (uint32_t i = 0; i < length; i++) {
+    lua_rawgeti(L, index, i + 1);
+    nodes[i] = luax_checknodeindex(L, -1, data);
+    lua_pop(L, 1);
+  }
+
+  *count = length;
+  return nodes;
+}
+
+static int l_lovrPoseGetModelData(lua_State* L) {
+  Pose* pose = luax_checktype(L, 1, Pose);
+  ModelData* data = lovrPoseGetModelData(pose);
+  luax_pushtype(L, ModelData, data);
+  return 1;
+}
+
+static int l_lovrPoseReset(lua_State* L) {
+  Pose* pose = luax_checktype(L, 1, Pose);
+  lovrPoseReset(pose);
+  return 0;
+}
+
+static int l_lovrPoseCopy(lua_State* L) {
+  Pose* pose = luax_checktype(L, 1, Pose);
+  Pose* source = luax_checktype(L, 2, Pose);
+  lovrPoseCopy(pose, source);
+  return 0;
+}
+
+static int l_lovrPoseSample(lua_State* L) {
+  Pose* pose = luax_checktype(L, 1, Pose);
+  uint32_t animation = luax_checkanimationindex(L, 2, lovrPoseGetModelData(pose));
+  float time = luax_checkfloat(L, 3);
+  float alpha = luax_optfloat(L, 4, 1.f);
+  lovrPoseSample(pose, animation, time, alpha);
+  return 0;
+}
+
+static int l_lovrPoseBlend(lua_State* L) {
+  Pose* pose = luax_checktype(L, 1, Pose);
+  Pose* source = luax_checktype(L, 2, Pose);
+  float alpha = luax_optfloat(L, 3, 1.f);
+  uint32_t defer = lovrDeferPush();
+  uint32_t stack[64], count;
+  uint32_t* mask = luax_checknodemask(L, 4, lovrPoseGetModelData(pose), stack, COUNTOF(stack), &count);
+  lovrPoseBlend(pose, source, alpha, mask, count);
+  lovrDeferPop(defer);
+  return 0;
+}
+
+static int l_lovrPoseAdd(lua_State* L) {
+  Pose* pose = luax_checktype(L, 1, Pose);
+  Pose* source = luax_checktype(L, 2, Pose);
+  float alpha = luax_optfloat(L, 3, 1.f);
+  uint32_t defer = lovrDeferPush();
+  uint32_t stack[64], count;
+  uint32_t* mask = luax_checknodemask(L, 4, lovrPoseGetModelData(pose), stack, COUNTOF(stack), &count);
+  lovrPoseAdd(pose, source, alpha, mask, count);
+  lovrDeferPop(defer);
+  return 0;
+}
+
+const luaL_Reg lovrPose[] = {
+  { "getModelData", l_lovrPoseGetModelData },
+  { "reset", l_lovrPoseReset },
+  { "copy", l_lovrPoseCopy },
+  { "sample", l_lovrPoseSample },
+  { "blend", l_lovrPoseBlend },
+  { "add", l_lovrPoseAdd },
+  { NULL, NULL }
+};
@@ -47,6 +47,12 @@ static int l_lovrShaderGetType(lua_State* L) {
   return 1;
 }
 
+static int l_lovrShaderIsComplete(lua_State* L) {
+  Shader* shader = luax_checktype(L, 1, Shader);
+  lua_pushboolean(L, lovrShaderIsComplete(shader));
+  return 1;
+}
+
 static int l_lovrShaderHasStage(lua_State* L) {
   Shader* shader = luax_checktype(L, 1, Shader);
   ShaderStage stage = luax_checkenum(L, 2, ShaderStage, NULL);
@@ -131,6 +137,7 @@ const luaL_Reg lovrShader[] = {
   { "clone", l_lovrShaderClone },
   { "getLabel", l_lovrShaderGetLabel },
   { "getType", l_lovrShaderGetType },
+  { "isComplete", l_lovrShaderIsComplete },
   { "hasStage", l_lovrShaderHasStage },
   { "hasAttribute", l_lovrShaderHasAttribute },
   { "getWorkgroupSize", l_lovrShaderGetWorkgroupSize },
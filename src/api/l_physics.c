@@ -86,6 +86,14 @@ static int l_lovrPhysicsNewWorld(lua_State* L) {
     if (!lua_isnil(L, -1)) info.positionSteps = luax_checku32(L, -1);
     lua_pop(L, 1);
 
+    lua_getfield(L, 1, "threads");
+    if (!lua_isnil(L, -1)) info.threadCount = luax_checku32(L, -1);
+    lua_pop(L, 1);
+
+    lua_getfield(L, 1, "snapshots");
+    if (!lua_isnil(L, -1)) info.snapshots = lua_toboolean(L, -1);
+    lua_pop(L, 1);
+
     lua_getfield(L, 1, "tags");
     if (!lua_isnil(L, -1)) {
       lovrCheck(lua_istable(L, -1), "World tag list should be a table");
@@ -1,5 +1,6 @@
 #include "api.h"
 #include "physics/physics.h"
+#include "data/blob.h"
 #include "core/maf.h"
 #include "util.h"
 #include <float.h>
@@ -292,6 +293,135 @@ static int l_lovrWorldGetJoints(lua_State* L) {
   return 1;
 }
 
+static Collider** luax_checkcolliderlist(lua_State* L, int index, World* world, uint32_t* count) {
+  luaL_checktype(L, index, LUA_TTABLE);
+  *count = luax_len(L, index);
+  Collider** colliders = lovrMalloc(MAX(*count, 1) * sizeof(Collider*));
+  lovrDefer(lovrFree, colliders);
+  for (uint32_t i = 0; i < *count; i++) {
+    lua_rawgeti(L, index, (int) i + 1);
+    Collider* collider = luax_checktype(L, -1, Collider);
+    lovrCheck(!lovrColliderIsDestroyed(collider), "Attempt to use a destroyed Collider");
+    lovrCheck(lovrColliderGetWorld(collider) == world, "Collider does not belong to this World");
+    colliders[i] = collider;
+    lua_pop(L, 1);
+  }
+  return colliders;
+}
+
+// Reads per-collider state into a table or Blob, with n floats per collider
+static int luax_getcolliderstate(lua_State* L, uint32_t n, void (*fn)(World*, Collider**, uint32_t, float*)) {
+  World* world = luax_checkworld(L, 1);
+  uint32_t defer = lovrDeferPush();
+  uint32_t count;
+  Collider** colliders = luax_checkcolliderlist(L, 2, world, &count);
+  size_t size = count * n * sizeof(float);
+
+  Blob* blob = luax_totype(L, 3, Blob);
+
+  if (blob) {
+    size_t offset = luax_optu32(L, 4, 0);
+    lovrCheck(offset + size <= blob->size, "This Blob can hold %d bytes, which is not enough space to hold %d bytes of data at the requested offset (%d)", (int) blob->size, (int) size, (int) offset);
+    fn(world, colliders, count, (float*) ((char*) blob->data + offset));
+    lua_settop(L, 3);
+  } else {
+    float* data = lovrMalloc(MAX(size, 1));
+    lovrDefer(lovrFree, data);
+    fn(world, colliders, count, data);
+
+    if (lua_istable(L, 3)) {
+      lua_settop(L, 3);
+    } else {
+      lua_createtable(L, (int) (count * n), 0);
+    }
+
+    for (uint32_t i = 0; i < count * n; i++) {
+      lua_pushnumber(L, data[i]);
+      lua_rawseti(L, -2, (int) i + 1);
+    }
+  }
+
+  lovrDeferPop(defer);
+  return 1;
+}
+
+static int luax_setcolliderstate(lua_State* L, uint32_t n, void (*fn)(World*, Collider**, uint32_t, float*)) {
+  World* world = luax_checkworld(L, 1);
+  uint32_t defer = lovrDeferPush();
+  uint32_t count;
+  Collider** colliders = luax_checkcolliderlist(L, 2, world, &count);
+  size_t size = count * n * sizeof(float);
+
+  Blob* blob = luax_totype(L, 3, Blob);
+
+  if (blob) {
+    size_t offset = luax_optu32(L, 4, 0);
+    lovrCheck(offset + size <= blob->size, "Tried to read past the end of the Blob");
+    fn(world, colliders, count, (float*) ((char*) blob->data + offset));
+  } else {
+    luaL_checktype(L, 3, LUA_TTABLE);
+    lovrCheck((uint32_t) luax_len(L, 3) >= count * n, "Expected %d numbers, got %d", count * n, luax_len(L, 3));
+    float* data = lovrMalloc(MAX(size, 1));
+    lovrDefer(lovrFree, data);
+
+    for (uint32_t i = 0; i < count * n; i++) {
+      lua_rawgeti(L, 3, (int) i + 1);
+      data[i] = luax_checkfloat(L, -1);
+      lua_pop(L, 1);
+    }
+
+    fn(world, colliders, count, data);
+  }
+
+  lovrDeferPop(defer);
+  return 0;
+}
+
+static int l_lovrWorldGetPoses(lua_State* L) {
+  return luax_getcolliderstate(L, 7, lovrWorldGetPoses);
+}
+
+static int l_lovrWorldSetPoses(lua_State* L) {
+  return luax_setcolliderstate(L, 7, lovrWorldSetPoses);
+}
+
+static int l_lovrWorldGetVelocities(lua_State* L) {
+  return luax_getcolliderstate(L, 6, lovrWorldGetVelocities);
+}
+
+static int l_lovrWorldSetVelocities(lua_State* L) {
+  return luax_setcolliderstate(L, 6, lovrWorldSetVelocities);
+}
+
+static int l_lovrWorldGetSnapshot(lua_State* L) {
+  World* world = luax_checkworld(L, 1);
+  const WorldSnapshot* snapshot = lovrWorldGetSnapshot(world);
+  lovrCheck(snapshot, "World snapshots are not enabled");
+  size_t size = snapshot->count * 16 * sizeof(float);
+  Blob* blob = luax_totype(L, 2, Blob);
+
+  if (blob) {
+    lovrCheck(size <= blob->size, "This Blob can hold %d bytes, which is not enough space to hold %d bytes of data", (int) blob->size, (int) size);
+    memcpy(blob->data, snapshot->transforms, size);
+    lua_settop(L, 2);
+  } else {
+    void* data = lovrMalloc(MAX(size, 1));
+    memcpy(data, snapshot->transforms, size);
+    blob = lovrBlobCreate(data, size, "World snapshot");
+    luax_pushtype(L, Blob, blob);
+    lovrRelease(blob, lovrBlobDestroy);
+  }
+
+  lua_createtable(L, (int) snapshot->count, 0);
+  for (uint32_t i = 0; i < snapshot->count; i++) {
+    luax_pushtype(L, Collider, snapshot->colliders[i]);
+    lua_rawseti(L, -2, (int) i + 1);
+  }
+
+  lua_insert(L, -2);
+  return 2;
+}
+
 static int l_lovrWorldGetGravity(lua_State* L) {
   World* world = luax_checkworld(L, 1);
   float gravity[3];
@@ -351,6 +481,66 @@ static int l_lovrWorldRaycast(lua_State* L) {
   return 0;
 }
 
+static int l_lovrWorldRaycastBatch(lua_State* L) {
+  World* world = luax_checkworld(L, 1);
+  Blob* rays = luax_totype(L, 2, Blob);
+  if (!rays) luaL_checktype(L, 2, LUA_TTABLE);
+  uint32_t count = rays ? (uint32_t) (rays->size / (6 * sizeof(float))) : luax_len(L, 2) / 6;
+  uint32_t filter = luax_checktagmask(L, 3, world);
+  Blob* blob = luax_totype(L, 4, Blob);
+  size_t size = count * 7 * sizeof(float);
+
+  if (blob) {
+    lovrCheck(size <= blob->size, "This Blob can hold %d bytes, which is not enough space to hold %d bytes of data", (int) blob->size, (int) size);
+    lua_settop(L, 4);
+  } else {
+    blob = lovrBlobCreate(lovrMalloc(MAX(size, 1)), size, "Raycast results");
+    luax_pushtype(L, Blob, blob);
+    lovrRelease(blob, lovrBlobDestroy);
+  }
+
+  uint32_t defer = lovrDeferPush();
+  float* data = rays ? rays->data : NULL;
+
+  if (!rays) {
+    data = lovrMalloc(MAX(count, 1) * 6 * sizeof(float));
+    lovrDefer(lovrFree, data);
+    for (uint32_t i = 0; i < count * 6; i++) {
+      lua_rawgeti(L, 2, (int) i + 1);
+      lovrCheck(lua_isnumber(L, -1), "Expected a number for ray component %d, got %s", (int) i + 1, luaL_typename(L, -1));
+      data[i] = luax_tofloat(L, -1);
+      lua_pop(L, 1);
+    }
+  }
+
+  CastResult* results = lovrMalloc(MAX(count, 1) * sizeof(CastResult));
+  lovrDefer(lovrFree, results);
+  lovrWorldRaycastBatch(world, data, count, filter, results);
+
+  float* result = blob->data;
+  lua_createtable(L, (int) count, 0);
+  lua_createtable(L, (int) count, 0);
+  for (uint32_t i = 0; i < count; i++, result += 7) {
+    CastResult* hit = &results[i];
+    if (hit->collider) {
+      luax_pushtype(L, Collider, hit->collider);
+      luax_pushshape(L, hit->shape);
+      memcpy(result + 0, hit->position, 3 * sizeof(float));
+      memcpy(result + 3, hit->normal, 3 * sizeof(float));
+      result[6] = hit->fraction;
+    } else {
+      lua_pushboolean(L, false);
+      lua_pushboolean(L, false);
+      memset(result, 0, 7 * sizeof(float));
+    }
+    lua_rawseti(L, -3, (int) i + 1);
+    lua_rawseti(L, -3, (int) i + 1);
+  }
+
+  lovrDeferPop(defer);
+  return 3;
+}
+
 static int l_lovrWorldShapecast(lua_State* L) {
   World* world = luax_checkworld(L, 1);
   int index = 2;
@@ -457,6 +647,25 @@ static int l_lovrWorldIsCollisionEnabledBetween(lua_State* L) {
   return 1;
 }
 
+static int l_lovrWorldGetTriggerEvents(lua_State* L) {
+  World* world = luax_checkworld(L, 1);
+  uint32_t count;
+  TriggerEvent* events = lovrWorldGetTriggerEvents(world, &count);
+  int enters = 0;
+  int exits = 0;
+  lua_newtable(L);
+  lua_newtable(L);
+  for (uint32_t i = 0; i < count; i++) {
+    int index = events[i].enter ? -2 : -1;
+    int* n = events[i].enter ? &enters : &exits;
+    luax_pushtype(L, Collider, events[i].sensor);
+    lua_rawseti(L, index - 1, ++*n);
+    luax_pushtype(L, Collider, events[i].collider);
+    lua_rawseti(L, index - 1, ++*n);
+  }
+  return 2;
+}
+
 static int l_lovrWorldGetCallbacks(lua_State* L) {
   luax_checkworld(L, 1);
   lua_settop(L, 1);
@@ -647,8 +856,14 @@ const luaL_Reg lovrWorld[] = {
   { "getJointCount", l_lovrWorldGetJointCount },
   { "getColliders", l_lovrWorldGetColliders },
   { "getJoints", l_lovrWorldGetJoints },
+  { "getPoses", l_lovrWorldGetPoses },
+  { "setPoses", l_lovrWorldSetPoses },
+  { "getVelocities", l_lovrWorldGetVelocities },
+  { "setVelocities", l_lovrWorldSetVelocities },
+  { "getSnapshot", l_lovrWorldGetSnapshot },
   { "update", l_lovrWorldUpdate },
   { "raycast", l_lovrWorldRaycast },
+  { "raycastBatch", l_lovrWorldRaycastBatch },
   { "shapecast", l_lovrWorldShapecast },
   { "overlapShape", l_lovrWorldOverlapShape },
   { "queryBox", l_lovrWorldQueryBox },
@@ -658,6 +873,7 @@ const luaL_Reg lovrWorld[] = {
   { "disableCollisionBetween", l_lovrWorldDisableCollisionBetween },
   { "enableCollisionBetween", l_lovrWorldEnableCollisionBetween },
   { "isCollisionEnabledBetween", l_lovrWorldIsCollisionEnabledBetween },
+  { "getTriggerEvents", l_lovrWorldGetTriggerEvents },
   { "getCallbacks", l_lovrWorldGetCallbacks },
   { "setCallbacks", l_lovrWorldSetCallbacks },
 
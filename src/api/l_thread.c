@@ -14,7 +14,8 @@ static void threadRun(void* L) {
   lua_pushinteger(L, status);
 }
 
-static char* threadRunner(Thread* thread, Blob* body, Variant* arguments, uint32_t argumentCount) {
+// Runs code in a new Lua state, the range (if any) is pushed as the first and last index
+static char* runCode(Blob* body, Variant* arguments, uint32_t argumentCount, uint32_t* range) {
   lua_State* L = luaL_newstate();
   luaL_openlibs(L);
   luax_preload(L);
@@ -22,6 +23,11 @@ static char* threadRunner(Thread* thread, Blob* body, Variant* arguments, uint32
   lua_pushcfunction(L, luax_getstack);
 
   if (!luaL_loadbuffer(L, body->data, body->size, "thread")) {
+    if (range) {
+      lua_pushinteger(L, range[0] + 1);
+      lua_pushinteger(L, range[0] + range[1]);
+    }
+
     for (uint32_t i = 0; i < argumentCount; i++) {
       luax_pushvariant(L, &arguments[i]);
     }
@@ -38,24 +44,27 @@ static char* threadRunner(Thread* thread, Blob* body, Variant* arguments, uint32
 
   size_t length;
   const char* message = lua_tolstring(L, -1, &length);
+  char* error = lovrMalloc(length + 1);
+  memcpy(error, message ? message : "", length);
+  error[length] = '\0';
+  lua_close(L);
+  return error;
+}
 
-  if (message) {
-    char* error = lovrMalloc(length + 1);
-    memcpy(error, message, length + 1);
-    lua_close(L);
-    return error;
-  }
+static char* threadRunner(Thread* thread, Blob* body, Variant* arguments, uint32_t argumentCount) {
+  return runCode(body, arguments, argumentCount, NULL);
+}
 
-  lua_close(L);
-  return NULL;
+static char* rangeRunner(Blob* body, Variant* arguments, uint32_t argumentCount, uint32_t start, uint32_t count) {
+  return runCode(body, arguments, argumentCount, (uint32_t[2]) { start, count });
 }
 
-static int l_lovrThreadNewThread(lua_State* L) {
-  uint32_t defer = lovrDeferPush();
-  Blob* blob = luax_totype(L, 1, Blob);
+// Note: the Blob is pushed to the defer stack if it needs to be released
+static Blob* luax_checkcode(lua_State* L, int index) {
+  Blob* blob = luax_totype(L, index, Blob);
   if (!blob) {
     size_t length;
-    const char* str = luaL_checklstring(L, 1, &length);
+    const char* str = luaL_checklstring(L, index, &length);
     if (memchr(str, '\n', MIN(1024, length))) {
       void* data = lovrMalloc(length + 1);
       memcpy(data, str, length + 1);
@@ -67,6 +76,12 @@ static int l_lovrThreadNewThread(lua_State* L) {
     }
     lovrDeferRelease(blob, lovrBlobDestroy);
   }
+  return blob;
+}
+
+static int l_lovrThreadNewThread(lua_State* L) {
+  uint32_t defer = lovrDeferPush();
+  Blob* blob = luax_checkcode(L, 1);
   Thread* thread = lovrThreadCreate(threadRunner, blob);
   luax_pushtype(L, Thread, thread);
   lovrRelease(thread, lovrThreadDestroy);
@@ -74,6 +89,38 @@ static int l_lovrThreadNewThread(lua_State* L) {
   return 1;
 }
 
+static void freeVariants(void* arg) {
+  Variant* arguments = arg;
+  for (uint32_t i = 0; i < MAX_THREAD_ARGUMENTS; i++) {
+    lovrVariantDestroy(&arguments[i]);
+  }
+}
+
+static int l_lovrThreadParallelFor(lua_State* L) {
+  uint32_t defer = lovrDeferPush();
+  Blob* blob = luax_checkcode(L, 1);
+  uint32_t count, grainSize = 0;
+  if (lua_istable(L, 2)) {
+    lua_getfield(L, 2, "count");
+    count = luax_checku32(L, -1);
+    lua_getfield(L, 2, "grain");
+    grainSize = lua_isnil(L, -1) ? 0 : luax_checku32(L, -1);
+    lua_pop(L, 2);
+  } else {
+    count = luax_checku32(L, 2);
+  }
+  uint32_t argumentCount = (uint32_t) MAX(lua_gettop(L) - 2, 0);
+  lovrCheck(argumentCount <= MAX_THREAD_ARGUMENTS, "Too many arguments (max is %d)", MAX_THREAD_ARGUMENTS);
+  Variant arguments[MAX_THREAD_ARGUMENTS] = { 0 };
+  lovrDefer(freeVariants, arguments);
+  for (uint32_t i = 0; i < argumentCount; i++) {
+    luax_checkvariant(L, 3 + i, &arguments[i]);
+  }
+  lovrThreadParallelFor(rangeRunner, blob, arguments, argumentCount, count, grainSize);
+  lovrDeferPop(defer);
+  return 0;
+}
+
 static int l_lovrThreadGetChannel(lua_State* L) {
   const char* name = luaL_checkstring(L, 1);
   Channel* channel = lovrThreadGetChannel(name);
@@ -84,6 +131,7 @@ static int l_lovrThreadGetChannel(lua_State* L) {
 
 static const luaL_Reg lovrThreadModule[] = {
   { "newThread", l_lovrThreadNewThread },
+  { "parallelFor", l_lovrThreadParallelFor },
   { "getChannel", l_lovrThreadGetChannel },
   { NULL, NULL }
 };
@@ -255,7 +255,7 @@ void* fs_map(const char* path, size_t* size) {
   *size = info.size;
   void* data = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, file.fd, 0);
   fs_close(file);
-  return data;
+  return data == MAP_FAILED ? NULL : data;
 }
 
 bool fs_unmap(void* data, size_t size) {
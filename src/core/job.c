@@ -1,72 +1,416 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // syscall
+#endif
+
 #include "job.h"
 #include <stdatomic.h>
 #include <threads.h>
 #include <string.h>
 
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h> // Defines _WIN32_WINNT, WaitOnAddress needs 0x0602 (Windows 8)
+#endif
+
 #define MAX_WORKERS 64
-#define MAX_JOBS 1024
+#define MAX_JOBS 4096
+#define JOB_MASK (MAX_JOBS - 1)
+#define SPIN_COUNT 32
+
+#define NONE (~0u)
+#define DONE (~0u - 1)
 
 struct job {
-  job* next;
   fn_job* fn;
   void* arg;
-  atomic_uint done;
+  job* parent;
+  job_group* group;
+  atomic_uint pending;
+  atomic_uint continuations;
+  atomic_uint next;
+  atomic_uint busy;
+  bool detached;
 };
 
+// Chase-Lev deque, only the owning worker pushes and pops from the bottom, everyone steals from the top
+typedef struct {
+  atomic_uint top;
+  uint32_t padding[15];
+  atomic_uint bottom;
+  atomic_uint slots[MAX_JOBS];
+} deque;
+
+// Bounded MPMC queue for jobs started by threads that aren't workers
+typedef struct {
+  atomic_uint head;
+  uint32_t padding[15];
+  atomic_uint tail;
+  struct {
+    atomic_uint sequence;
+    uint32_t index;
+  } cells[MAX_JOBS];
+} queue;
+
 static struct {
   job jobs[MAX_JOBS];
+  deque deques[MAX_WORKERS];
+  queue queue;
   thrd_t workers[MAX_WORKERS];
   uint32_t workerCount;
-  job* head;
-  job* tail;
-  job* pool;
-  cnd_t hasJob;
-  mtx_t lock;
-  bool quit;
+  atomic_uint pool;
+  atomic_uint workSignal;
+  atomic_uint doneSignal;
+  atomic_uint idleWorkers;
+  atomic_uint waiters;
+  atomic_uint quit;
+  mtx_t parkLock;
+  cnd_t parked;
 } state;
 
-// Must hold lock, this will unlock it, state.head must exist
-static void runJob(void) {
-  job* job = state.head;
-  state.head = job->next;
-  if (!job->next) state.tail = NULL;
-  mtx_unlock(&state.lock);
+static thread_local uint32_t worker = NONE;
+static thread_local uint32_t seed = 1;
+static thread_local job* current;
+
+// Parking
+
+#if defined(__linux__)
+static void park(atomic_uint* signal, uint32_t value) {
+  syscall(SYS_futex, signal, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);
+}
+
+static void unpark(atomic_uint* signal, bool all) {
+  syscall(SYS_futex, signal, FUTEX_WAKE_PRIVATE, all ? INT32_MAX : 1, NULL, NULL, 0);
+}
+#elif defined(_WIN32) && _WIN32_WINNT >= 0x0602
+static void park(atomic_uint* signal, uint32_t value) {
+  WaitOnAddress((volatile void*) signal, &value, sizeof(value), INFINITE);
+}
+
+static void unpark(atomic_uint* signal, bool all) {
+  if (all) {
+    WakeByAddressAll((void*) signal);
+  } else {
+    WakeByAddressSingle((void*) signal);
+  }
+}
+#else
+static void park(atomic_uint* signal, uint32_t value) {
+  mtx_lock(&state.parkLock);
+  while (atomic_load(signal) == value) {
+    cnd_wait(&state.parked, &state.parkLock);
+  }
+  mtx_unlock(&state.parkLock);
+}
+
+static void unpark(atomic_uint* signal, bool all) {
+  mtx_lock(&state.parkLock);
+  cnd_broadcast(&state.parked);
+  mtx_unlock(&state.parkLock);
+}
+#endif
+
+// Pool (lock-free stack, low 16 bits are index + 1 so a zeroed pool is empty, high 16 bits are a tag)
+
+static job* allocJob(void) {
+  uint32_t head = atomic_load(&state.pool);
+  for (;;) {
+    uint32_t index = head & 0xffff;
+    if (index == 0) return NULL;
+    uint32_t next = atomic_load_explicit(&state.jobs[index - 1].next, memory_order_relaxed);
+    uint32_t tag = (head >> 16) + 1;
+    if (atomic_compare_exchange_strong(&state.pool, &head, (tag << 16) | next)) {
+      return &state.jobs[index - 1];
+    }
+  }
+}
+
+static void freeJob(job* job) {
+  uint32_t index = (uint32_t) (job - state.jobs) + 1;
+  uint32_t head = atomic_load(&state.pool);
+  do {
+    atomic_store_explicit(&job->next, head & 0xffff, memory_order_relaxed);
+  } while (!atomic_compare_exchange_strong(&state.pool, &head, (((head >> 16) + 1) << 16) | index));
+}
+
+// Deque (there can never be more than MAX_JOBS jobs in flight, so it can't overflow)
+
+static void dequePush(deque* d, uint32_t index) {
+  uint32_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+  atomic_store_explicit(&d->slots[b & JOB_MASK], index, memory_order_relaxed);
+  atomic_store_explicit(&d->bottom, b + 1, memory_order_release);
+}
+
+static uint32_t dequePop(deque* d) {
+  uint32_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+  atomic_store(&d->bottom, b);
+  uint32_t t = atomic_load(&d->top);
+
+  if ((int32_t) (b - t) < 0) {
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    return NONE;
+  }
+
+  uint32_t index = atomic_load_explicit(&d->slots[b & JOB_MASK], memory_order_relaxed);
+
+  if (b == t) {
+    if (!atomic_compare_exchange_strong(&d->top, &t, t + 1)) {
+      index = NONE;
+    }
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+  }
+
+  return index;
+}
+
+static uint32_t dequeSteal(deque* d) {
+  for (;;) {
+    uint32_t t = atomic_load(&d->top);
+    uint32_t b = atomic_load(&d->bottom);
+
+    if ((int32_t) (b - t) <= 0) {
+      return NONE;
+    }
+
+    uint32_t index = atomic_load_explicit(&d->slots[t & JOB_MASK], memory_order_relaxed);
+
+    if (atomic_compare_exchange_strong(&d->top, &t, t + 1)) {
+      return index;
+    }
+  }
+}
+
+// Queue
+
+static void queuePush(queue* q, uint32_t index) {
+  uint32_t position = atomic_load_explicit(&q->tail, memory_order_relaxed);
+  for (;;) {
+    uint32_t sequence = atomic_load_explicit(&q->cells[position & JOB_MASK].sequence, memory_order_acquire);
+    int32_t delta = (int32_t) (sequence - position);
+    if (delta == 0) {
+      if (atomic_compare_exchange_strong(&q->tail, &position, position + 1)) {
+        break;
+      }
+    } else {
+      position = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    }
+  }
+  q->cells[position & JOB_MASK].index = index;
+  atomic_store_explicit(&q->cells[position & JOB_MASK].sequence, position + 1, memory_order_release);
+}
+
+static uint32_t queuePop(queue* q) {
+  uint32_t position = atomic_load_explicit(&q->head, memory_order_relaxed);
+  for (;;) {
+    uint32_t sequence = atomic_load_explicit(&q->cells[position & JOB_MASK].sequence, memory_order_acquire);
+    int32_t delta = (int32_t) (sequence - (position + 1));
+    if (delta == 0) {
+      if (atomic_compare_exchange_strong(&q->head, &position, position + 1)) {
+        break;
+      }
+    } else if (delta < 0) {
+      return NONE;
+    } else {
+      position = atomic_load_explicit(&q->head, memory_order_relaxed);
+    }
+  }
+  uint32_t index = q->cells[position & JOB_MASK].index;
+  atomic_store_explicit(&q->cells[position & JOB_MASK].sequence, position + MAX_JOBS, memory_order_release);
+  return index;
+}
+
+// Scheduling
+
+static void notify(atomic_uint* signal, bool all) {
+  atomic_fetch_add(signal, 1);
+  unpark(signal, all);
+}
+
+static void enqueue(job* job) {
+  uint32_t index = (uint32_t) (job - state.jobs);
+
+  if (worker == NONE) {
+    queuePush(&state.queue, index);
+  } else {
+    dequePush(&state.deques[worker], index);
+  }
+}
 
+static void wake(uint32_t count) {
+  if (atomic_load(&state.idleWorkers) > 0) {
+    notify(&state.workSignal, count > 1);
+  } else {
+    atomic_fetch_add(&state.workSignal, 1);
+  }
+
+  if (atomic_load(&state.waiters) > 0) {
+    notify(&state.doneSignal, true);
+  }
+}
+
+static void push(job* job) {
+  enqueue(job);
+  wake(1);
+}
+
+static job* findJob(void) {
+  uint32_t index = NONE;
+
+  if (worker != NONE) {
+    index = dequePop(&state.deques[worker]);
+  }
+
+  if (index == NONE) {
+    index = queuePop(&state.queue);
+  }
+
+  if (index == NONE && state.workerCount > 0) {
+    uint32_t count = state.workerCount;
+    seed = seed * 1664525 + 1013904223;
+    uint32_t start = (seed >> 16) % count;
+    for (uint32_t i = 0; i < count && index == NONE; i++) {
+      uint32_t victim = (start + i) % count;
+      if (victim != worker) {
+        index = dequeSteal(&state.deques[victim]);
+      }
+    }
+  }
+
+  return index == NONE ? NULL : &state.jobs[index];
+}
+
+static void finishJob(job* job) {
+  if (atomic_fetch_sub(&job->pending, 1) != 1) {
+    return;
+  }
+
+  struct job* parent = job->parent;
+  job_group* group = job->group;
+
+  uint32_t index = atomic_exchange(&job->continuations, DONE);
+  while (index != NONE) {
+    struct job* continuation = &state.jobs[index];
+    index = atomic_load_explicit(&continuation->next, memory_order_relaxed);
+    push(continuation);
+  }
+
+  if (job->detached) {
+    freeJob(job);
+  } else {
+    atomic_store(&job->busy, 0);
+    if (atomic_load(&state.waiters) > 0) {
+      notify(&state.doneSignal, true);
+    }
+  }
+
+  if (group && atomic_fetch_sub(&group->pending, 1) == 1 && atomic_load(&state.waiters) > 0) {
+    notify(&state.doneSignal, true);
+  }
+
+  if (parent) {
+    finishJob(parent);
+  }
+}
+
+static void runJob(job* job) {
+  struct job* previous = current;
+  current = job;
   job->fn(job->arg);
-  job->done = true;
+  current = previous;
+  finishJob(job);
+}
+
+// Helps out with other jobs until the counter reaches zero
+static void waitFor(atomic_uint* counter) {
+  while (atomic_load(counter) > 0) {
+    job* job = findJob();
+
+    if (job) {
+      runJob(job);
+      continue;
+    }
+
+    uint32_t value = atomic_load(&state.doneSignal);
+    atomic_fetch_add(&state.waiters, 1);
+
+    if (atomic_load(counter) > 0 && (job = findJob()) == NULL) {
+      park(&state.doneSignal, value);
+    }
+
+    atomic_fetch_sub(&state.waiters, 1);
+
+    if (job) {
+      runJob(job);
+    }
+  }
 }
 
 static int workerLoop(void* arg) {
-  for (;;) {
-    mtx_lock(&state.lock);
+  worker = (uint32_t) (uintptr_t) arg;
+  seed += worker;
+
+  while (!atomic_load(&state.quit)) {
+    job* job = NULL;
 
-    while (!state.head && !state.quit) {
-      cnd_wait(&state.hasJob, &state.lock);
+    for (uint32_t i = 0; i < SPIN_COUNT && !job; i++) {
+      job = findJob();
     }
 
-    if (state.quit) {
-      break;
+    if (!job) {
+      uint32_t value = atomic_load(&state.workSignal);
+      atomic_fetch_add(&state.idleWorkers, 1);
+
+      if (!atomic_load(&state.quit) && (job = findJob()) == NULL) {
+        park(&state.workSignal, value);
+      }
+
+      atomic_fetch_sub(&state.idleWorkers, 1);
     }
 
-    runJob();
+    if (job) {
+      runJob(job);
+    }
   }
 
-  mtx_unlock(&state.lock);
   return 0;
 }
 
+static job* newJob(fn_job* fn, void* arg) {
+  job* job = allocJob();
+
+  if (job) {
+    job->fn = fn;
+    job->arg = arg;
+    job->parent = NULL;
+    job->group = NULL;
+    job->detached = true;
+    atomic_store(&job->pending, 1);
+    atomic_store(&job->continuations, NONE);
+    atomic_store(&job->busy, 1);
+  }
+
+  return job;
+}
+
 bool job_init(uint32_t count) {
-  mtx_init(&state.lock, mtx_plain);
-  cnd_init(&state.hasJob);
+  mtx_init(&state.parkLock, mtx_plain);
+  cnd_init(&state.parked);
 
-  state.pool = state.jobs;
-  for (uint32_t i = 0; i < MAX_JOBS - 1; i++) {
-    state.jobs[i].next = &state.jobs[i + 1];
+  for (uint32_t i = 0; i < MAX_JOBS; i++) {
+    atomic_store(&state.jobs[i].next, i + 1 < MAX_JOBS ? i + 2 : 0);
+    atomic_store(&state.queue.cells[i].sequence, i);
   }
 
+  atomic_store(&state.pool, 1);
+
   if (count > MAX_WORKERS) count = MAX_WORKERS;
-  for (uint32_t i = 0; i < count; i++, state.workerCount++) {
+  state.workerCount = count;
+  for (uint32_t i = 0; i < count; i++) {
     if (thrd_create(&state.workers[i], workerLoop, (void*) (uintptr_t) i) != thrd_success) {
+      state.workerCount = i;
       return false;
     }
   }
@@ -75,62 +419,164 @@ bool job_init(uint32_t count) {
 }
 
 void job_destroy(void) {
-  state.quit = true;
-  cnd_broadcast(&state.hasJob);
+  atomic_store(&state.quit, 1);
+  notify(&state.workSignal, true);
   for (uint32_t i = 0; i < state.workerCount; i++) {
     thrd_join(state.workers[i], NULL);
   }
-  cnd_destroy(&state.hasJob);
-  mtx_destroy(&state.lock);
+  cnd_destroy(&state.parked);
+  mtx_destroy(&state.parkLock);
   memset(&state, 0, sizeof(state));
 }
 
 job* job_start(fn_job* fn, void* arg) {
-  mtx_lock(&state.lock);
+  job* job = newJob(fn, arg);
 
-  if (!state.pool) {
-    mtx_unlock(&state.lock);
+  if (!job) {
     fn(arg);
     return NULL;
   }
 
-  job* job = state.pool;
-  state.pool = job->next;
+  job->detached = false;
+  push(job);
+  return job;
+}
 
-  if (state.tail) {
-    state.tail->next = job;
-    state.tail = job;
-  } else {
-    state.head = job;
-    state.tail = job;
-    cnd_signal(&state.hasJob);
+// Starts a child of the job running on this thread.  The parent doesn't finish until its children
+// do.  Outside of a job, this just runs the function.
+void job_spawn(fn_job* fn, void* arg) {
+  job* job = current ? newJob(fn, arg) : NULL;
+
+  if (!job) {
+    fn(arg);
+    return;
   }
 
-  job->next = NULL;
-  job->done = false;
-  job->fn = fn;
-  job->arg = arg;
+  job->parent = current;
+  atomic_fetch_add(&current->pending, 1);
+  push(job);
+}
 
-  mtx_unlock(&state.lock);
-  return job;
+// Starts a job once another one finishes, must be called before waiting on the job
+void job_then(job* job, fn_job* fn, void* arg) {
+  if (!job) {
+    fn(arg);
+    return;
+  }
+
+  struct job* continuation = newJob(fn, arg);
+
+  if (!continuation) {
+    waitFor(&job->busy);
+    fn(arg);
+    return;
+  }
+
+  uint32_t index = (uint32_t) (continuation - state.jobs);
+  uint32_t head = atomic_load(&job->continuations);
+  do {
+    if (head == DONE) {
+      push(continuation);
+      return;
+    }
+    atomic_store_explicit(&continuation->next, head, memory_order_relaxed);
+  } while (!atomic_compare_exchange_strong(&job->continuations, &head, index));
 }
 
 void job_wait(job* job) {
   if (!job) return;
+  waitFor(&job->busy);
+  freeJob(job);
+}
 
-  while (!job->done) {
-    mtx_lock(&state.lock);
+void job_group_start(job_group* group, fn_job* fn, void* arg) {
+  job* job = newJob(fn, arg);
 
-    if (state.head) {
-      runJob();
-    } else {
-      mtx_unlock(&state.lock);
-      thrd_yield();
+  if (!job) {
+    fn(arg);
+    return;
+  }
+
+  job->group = group;
+  atomic_fetch_add(&group->pending, 1);
+  push(job);
+}
+
+// Starts a job for each argument, waking workers once for the whole batch.  A stride of zero passes
+// the same argument to every job.
+void job_group_start_batch(job_group* group, fn_job* fn, void* args, size_t stride, uint32_t count) {
+  uint32_t started = 0;
+
+  for (uint32_t i = 0; i < count; i++) {
+    void* arg = (char*) args + i * stride;
+    job* job = newJob(fn, arg);
+
+    if (!job) {
+      fn(arg);
+      continue;
     }
+
+    job->group = group;
+    atomic_fetch_add(&group->pending, 1);
+    enqueue(job);
+    started++;
+  }
+
+  if (started > 0) {
+    wake(started);
+  }
+}
+
+void job_group_wait(job_group* group) {
+  waitFor(&group->pending);
+}
+
+typedef struct {
+  fn_job_range* fn;
+  void* arg;
+  uint32_t count;
+  uint32_t grainSize;
+  uint32_t chunkCount;
+  atomic_uint cursor;
+} range;
+
+static void runRange(void* arg) {
+  range* r = arg;
+  for (;;) {
+    uint32_t chunk = atomic_fetch_add(&r->cursor, 1);
+    if (chunk >= r->chunkCount) break;
+    uint32_t start = chunk * r->grainSize;
+    uint32_t count = r->count - start < r->grainSize ? r->count - start : r->grainSize;
+    r->fn(r->arg, start, count);
+  }
+}
+
+// Splits a range into chunks of grainSize items (0 picks a size based on the worker count).  The
+// calling thread helps out, and this returns once every item is processed.
+void job_parallel_for(uint32_t count, uint32_t grainSize, fn_job_range* fn, void* arg) {
+  if (count == 0) return;
+
+  if (grainSize == 0) {
+    grainSize = count / ((state.workerCount + 1) * 4);
+    if (grainSize == 0) grainSize = 1;
   }
 
-  mtx_lock(&state.lock);
-  job->next = state.pool;
-  state.pool = job;
-  mtx_unlock(&state.lock);
+  range r = {
+    .fn = fn,
+    .arg = arg,
+    .count = count,
+    .grainSize = grainSize,
+    .chunkCount = count / grainSize + (count % grainSize != 0)
+  };
+
+  uint32_t helpers = r.chunkCount - 1 < state.workerCount ? r.chunkCount - 1 : state.workerCount;
+
+  job_group group = { 0 };
+  job_group_start_batch(&group, runRange, &r, 0, helpers);
+  runRange(&r);
+  job_group_wait(&group);
+}
+
+uint32_t job_get_worker_count(void) {
+  return state.workerCount;
 }
@@ -1,13 +1,28 @@
 #include <stdarg.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 
 #pragma once
 
 typedef struct job job;
 typedef void fn_job(void* arg);
+typedef void fn_job_range(void* arg, uint32_t start, uint32_t count);
+
+// Counts outstanding jobs so they can all be waited on at once, zero-initialize before use
+typedef struct {
+  atomic_uint pending;
+} job_group;
 
 bool job_init(uint32_t workerCount);
 void job_destroy(void);
 job* job_start(fn_job* fn, void* arg);
+void job_spawn(fn_job* fn, void* arg);
+void job_then(job* job, fn_job* fn, void* arg);
 void job_wait(job* job);
+void job_group_start(job_group* group, fn_job* fn, void* arg);
+void job_group_start_batch(job_group* group, fn_job* fn, void* args, size_t stride, uint32_t count);
+void job_group_wait(job_group* group);
+void job_parallel_for(uint32_t count, uint32_t grainSize, fn_job_range* fn, void* arg);
+uint32_t job_get_worker_count(void);
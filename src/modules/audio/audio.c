@@ -5,6 +5,7 @@
 #include "util.h"
 #include "lib/miniaudio/miniaudio.h"
 #include <stdatomic.h>
+#include <threads.h>
 #include <string.h>
 #include <stdlib.h>
 #include <math.h>
@@ -14,10 +15,19 @@
 #else
 #define CTZL __builtin_ctzl
 #endif
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define MIX_SSE
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MIX_NEON
+#endif
 
-#define FOREACH_SOURCE(s) for (uint64_t m = state.sourceMask; s = m ? state.sources[CTZL(m)] : NULL, m; m ^= (m & -m))
+#define SOURCE_WORDS (MAX_SOURCES / 64)
+#define FOREACH_SOURCE(s) for (uint32_t w = 0; w < SOURCE_WORDS; w++) for (uint64_t m = state.sourceMask[w]; s = m ? state.sources[w * 64 + CTZL(m)] : NULL, m; m ^= (m & -m))
 #define OUTPUT_FORMAT SAMPLE_F32
 #define OUTPUT_CHANNELS 2
+#define MAX_COMMANDS 1024
 
 struct Source {
   uint32_t ref;
@@ -26,7 +36,7 @@ struct Source {
   // Note: Converter is written once in lovrSourceCreate and can never be changed.
   ma_data_converter* converter;
   intptr_t spatializerMemo;
-  uint32_t offset;
+  atomic_uint offset;
   float pitch;
   float volume;
   float position[3];
@@ -35,27 +45,65 @@ struct Source {
   float dipoleWeight;
   float dipolePower;
   uint8_t effects;
-  bool playing;
+  atomic_bool reserved;
+  atomic_bool playing;
   bool looping;
   bool pitchable;
   bool spatial;
 };
 
+// Sources are only added and repitched by the mixer, other threads send it commands
+typedef enum {
+  COMMAND_PLAY,
+  COMMAND_PITCH,
+  COMMAND_ABSORPTION
+} CommandType;
+
+typedef struct {
+  CommandType type;
+  Source* source;
+  union {
+    float ratio;
+    float absorption[3];
+  };
+} Command;
+
+// Bounded lock-free queue, each slot's sequence says whether it's ready to be written or read
+typedef struct {
+  atomic_uint sequence;
+  Command command;
+} CommandSlot;
+
+typedef struct {
+  Source* source;
+  float audibility;
+} Voice;
+
 static struct {
   uint32_t ref;
-  ma_mutex lock;
+  atomic_bool spatializerLock;
   ma_context context;
   ma_device devices[2];
   ma_device_info* deviceInfo[2];
   Sound* sinks[2];
   Source* sources[MAX_SOURCES];
-  uint64_t sourceMask;
+  uint64_t sourceMask[SOURCE_WORDS];
+  atomic_uint sourceCount;
+  atomic_uint activeVoices;
+  atomic_uint virtualVoices;
+  CommandSlot commands[MAX_COMMANDS];
+  atomic_uint commandHead;
+  atomic_uint commandTail;
   float position[3];
   float orientation[4];
   Spatializer* spatializer;
   float absorption[3];
+  float mixAbsorption[3];
   ma_data_converter playbackConverter;
   uint32_t sampleRate;
+  float rendered[BUFFER_SIZE * OUTPUT_CHANNELS];
+  uint32_t renderedCount;
+  uint32_t renderedCursor;
 } state;
 
 static const ma_format miniaudioFormats[] = {
@@ -63,6 +111,21 @@ static const ma_format miniaudioFormats[] = {
   [SAMPLE_F32] = ma_format_f32
 };
 
+// The mixer only ever tries to take this, so changing geometry can't stall it
+static bool trySpatializerLock(void) {
+  return !atomic_exchange_explicit(&state.spatializerLock, true, memory_order_acquire);
+}
+
+static void lockSpatializer(void) {
+  while (!trySpatializerLock()) {
+    thrd_yield();
+  }
+}
+
+static void unlockSpatializer(void) {
+  atomic_store_explicit(&state.spatializerLock, false, memory_order_release);
+}
+
 static float dbToLinear(float db) {
   return powf(10.f, db / 20.f);
 }
@@ -71,34 +134,281 @@ static float linearToDb(float linear) {
   return 20.f * log10f(linear);
 }
 
-// Device callbacks
+// Commands
 
-static void onPlayback(ma_device* device, void* out, const void* in, uint32_t count) {
-  lovrAssert(count == BUFFER_SIZE, "Unreachable");
+static bool pushCommand(Command* command) {
+  uint32_t position = atomic_load_explicit(&state.commandHead, memory_order_relaxed);
+  CommandSlot* slot;
+
+  for (;;) {
+    slot = &state.commands[position & (MAX_COMMANDS - 1)];
+    uint32_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+    int32_t difference = (int32_t) (sequence - position);
+    if (difference == 0) {
+      if (atomic_compare_exchange_weak_explicit(&state.commandHead, &position, position + 1, memory_order_relaxed, memory_order_relaxed)) {
+        break;
+      }
+    } else if (difference < 0) {
+      return false;
+    } else {
+      position = atomic_load_explicit(&state.commandHead, memory_order_relaxed);
+    }
+  }
+
+  slot->command = *command;
+  atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+  return true;
+}
+
+static bool popCommand(Command* command) {
+  uint32_t position = atomic_load_explicit(&state.commandTail, memory_order_relaxed);
+  CommandSlot* slot;
+
+  for (;;) {
+    slot = &state.commands[position & (MAX_COMMANDS - 1)];
+    uint32_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+    int32_t difference = (int32_t) (sequence - (position + 1));
+    if (difference == 0) {
+      if (atomic_compare_exchange_weak_explicit(&state.commandTail, &position, position + 1, memory_order_relaxed, memory_order_relaxed)) {
+        break;
+      }
+    } else if (difference < 0) {
+      return false;
+    } else {
+      position = atomic_load_explicit(&state.commandTail, memory_order_relaxed);
+    }
+  }
+
+  *command = slot->command;
+  atomic_store_explicit(&slot->sequence, position + MAX_COMMANDS, memory_order_release);
+  return true;
+}
+
+// Each Source in the mixer, or on its way there, holds one of the MAX_SOURCES slots
+static bool reserveSource(Source* source) {
+  if (atomic_exchange(&source->reserved, true)) {
+    return true;
+  }
+
+  if (atomic_fetch_add(&state.sourceCount, 1) >= MAX_SOURCES) {
+    atomic_fetch_sub(&state.sourceCount, 1);
+    atomic_store(&source->reserved, false);
+    return false;
+  }
+
+  return true;
+}
+
+// Runs on the mixer, or on the thread sending the command when nothing is mixing.  The caller holds
+// the spatializer lock.
+static void processCommands(void) {
+  Command command;
+  while (popCommand(&command)) {
+    Source* source = command.source;
+
+    switch (command.type) {
+      case COMMAND_PLAY:
+        if (source->index == ~0u) {
+          // The slot from lovrSourcePlay is gone if the mixer removed the Source after it was played
+          if (!reserveSource(source)) {
+            atomic_store(&source->playing, false);
+            break;
+          }
+
+          uint32_t word = 0;
+          while (state.sourceMask[word] == ~0ull) word++;
+          uint32_t index = word * 64 + (state.sourceMask[word] ? CTZL(~state.sourceMask[word]) : 0);
+          state.sourceMask[word] |= (1ull << (index % 64));
+          state.sources[index] = source;
+          source->index = index;
+          state.spatializer->sourceCreate(source);
+          continue; // The command's reference becomes the mixer's reference
+        }
+        break;
+      case COMMAND_PITCH:
+        ma_data_converter_set_rate_ratio(source->converter, command.ratio);
+        break;
+      case COMMAND_ABSORPTION:
+        memcpy(state.mixAbsorption, command.absorption, sizeof(state.mixAbsorption));
+        break;
+      default: break;
+    }
+
+    lovrRelease(source, lovrSourceDestroy);
+  }
+}
+
+// Commands hold a reference to their Source, so it stays alive until the command is processed
+static void sendCommand(Command command) {
+  lovrRetain(command.source);
+
+  while (!pushCommand(&command)) {
+    if (ma_device_is_started(&state.devices[AUDIO_PLAYBACK])) {
+      thrd_yield();
+    } else {
+      lockSpatializer();
+      processCommands();
+      unlockSpatializer();
+    }
+  }
+
+  if (!ma_device_is_started(&state.devices[AUDIO_PLAYBACK])) {
+    lockSpatializer();
+    processCommands();
+    unlockSpatializer();
+  }
+}
+
+// Mixing
+
+static void mixSamples(float* restrict dst, const float* restrict src, float volume, uint32_t count) {
+  uint32_t i = 0;
+#if defined(MIX_SSE)
+  __m128 v = _mm_set1_ps(volume);
+  for (; i + 8 <= count; i += 8) {
+    __m128 a = _mm_add_ps(_mm_loadu_ps(dst + i + 0), _mm_mul_ps(_mm_loadu_ps(src + i + 0), v));
+    __m128 b = _mm_add_ps(_mm_loadu_ps(dst + i + 4), _mm_mul_ps(_mm_loadu_ps(src + i + 4), v));
+    _mm_storeu_ps(dst + i + 0, a);
+    _mm_storeu_ps(dst + i + 4, b);
+  }
+#elif defined(MIX_NEON)
+  float32x4_t v = vdupq_n_f32(volume);
+  for (; i + 8 <= count; i += 8) {
+    vst1q_f32(dst + i + 0, vmlaq_f32(vld1q_f32(dst + i + 0), vld1q_f32(src + i + 0), v));
+    vst1q_f32(dst + i + 4, vmlaq_f32(vld1q_f32(dst + i + 4), vld1q_f32(src + i + 4), v));
+  }
+#endif
+  for (; i < count; i++) {
+    dst[i] += src[i] * volume;
+  }
+}
+
+// Rough loudness used to pick which sources get mixed, streams sort first since they always get
+// mixed (skipping them would require decoding them anyway)
+static float getAudibility(Source* source) {
+  if (lovrSoundIsStream(source->sound)) {
+    return HUGE_VALF;
+  }
+
+  float audibility = source->volume;
+
+  if (source->spatial && (source->effects & (1 << EFFECT_ATTENUATION))) {
+    float distance = vec3_distance(source->position, state.position);
+    audibility /= MAX(distance, 1.f);
+  }
+
+  return audibility;
+}
+
+static int compareVoices(const void* a, const void* b) {
+  float x = ((const Voice*) a)->audibility;
+  float y = ((const Voice*) b)->audibility;
+  return (x < y) - (x > y);
+}
+
+// Seeks write the offset directly so tell sees them right away.  The mixer only moves the offset
+// forward if it hasn't changed since the mix started, so a seek during a mix isn't lost.  The same
+// goes for stopping a Source that reached its end, since stop + play restarts it with a seek.
+static uint32_t loadOffset(Source* source) {
+  return atomic_load(&source->offset);
+}
+
+static void storeOffset(Source* source, uint32_t start, uint32_t offset, bool finished) {
+  if (atomic_compare_exchange_strong(&source->offset, &start, offset) && finished) {
+    atomic_store(&source->playing, false);
+  }
+}
+
+// Virtual voices keep their place in the sound without decoding or mixing anything
+static void skipSource(Source* source) {
+  uint32_t frameCount = lovrSoundGetFrameCount(source->sound);
+  float ratio = (float) lovrSoundGetSampleRate(source->sound) / state.sampleRate * source->pitch;
+  uint32_t start = loadOffset(source);
+  uint32_t offset = start + (uint32_t) (BUFFER_SIZE * ratio + .5f);
+  bool finished = false;
+
+  if (offset >= frameCount) {
+    if (source->looping && frameCount > 0) {
+      offset %= frameCount;
+    } else {
+      offset = 0;
+      finished = true;
+    }
+  }
+
+  storeOffset(source, start, offset, finished);
+}
+
+// Mixes BUFFER_SIZE stereo frames into dst
+static void mixSources(float* dst) {
   float raw[BUFFER_SIZE * 2];
   float aux[BUFFER_SIZE * 2];
   float mix[BUFFER_SIZE * 2];
-  float* dst = out;
   float* buf = NULL; // The "current" buffer (used for fast paths)
+  Voice voices[MAX_SOURCES];
+  uint32_t voiceCount = 0;
 
-  ma_mutex_lock(&state.lock);
+  // If the geometry is being changed, nothing touches the spatializer for this buffer: commands and
+  // removals wait for the next one, and spatial voices are virtualized
+  bool spatialize = trySpatializerLock();
+
+  if (spatialize) {
+    processCommands();
+  }
 
   Source* source;
   FOREACH_SOURCE(source) {
-    if (!source->playing) {
+    if (!atomic_load(&source->playing)) {
+      if (!spatialize) continue;
       state.sources[source->index] = NULL;
-      state.sourceMask &= ~(1ull << source->index);
+      state.sourceMask[source->index / 64] &= ~(1ull << (source->index % 64));
       state.spatializer->sourceDestroy(source);
       source->index = ~0u;
+      atomic_fetch_sub(&state.sourceCount, 1);
+      atomic_store(&source->reserved, false);
       lovrRelease(source, lovrSourceDestroy);
       continue;
     }
 
+    voices[voiceCount++] = (Voice) { source, getAudibility(source) };
+  }
+
+  // Streams don't count towards MAX_VOICES, only the loudest of the other voices are mixed and the
+  // rest are virtualized
+  if (voiceCount > MAX_VOICES) {
+    qsort(voices, voiceCount, sizeof(Voice), compareVoices);
+  }
+
+  uint32_t budget = MAX_VOICES;
+  uint32_t mixed = 0;
+  for (uint32_t v = 0; v < voiceCount; v++) {
+    source = voices[v].source;
+    bool stream = lovrSoundIsStream(source->sound);
+
+    if (source->spatial && !spatialize) {
+      if (!stream) skipSource(source);
+      continue;
+    }
+
+    if (!stream) {
+      if (budget == 0 || voices[v].audibility <= 0.f) {
+        skipSource(source);
+        continue;
+      }
+
+      budget--;
+    }
+
+    mixed++;
+
     // Read and convert raw frames until there's BUFFER_SIZE converted frames
     // - No converter: just read frames into raw (it has enough space for BUFFER_SIZE frames).
     // - Converter: keep reading as many frames as possible/needed into raw and convert into aux.
     // - If EOF is reached, rewind and continue for looping sources, otherwise pad end with zero.
     buf = source->converter ? aux : raw;
+    uint32_t start = loadOffset(source);
+    uint32_t offset = start;
+    bool finished = false;
     float* cursor = buf; // Edge of processed frames
     uint32_t channelsOut = source->spatial ? 1 : 2; // If spatializer isn't converting to stereo, converter must do it
     uint32_t framesRemaining = BUFFER_SIZE;
@@ -110,23 +420,23 @@ static void onPlayback(ma_device* device, void* out, const void* in, uint32_t co
         uint32_t capacity = sizeof(raw) / (channelsIn * sizeof(float));
         ma_uint64 chunk;
         ma_data_converter_get_required_input_frame_count(source->converter, framesRemaining, &chunk);
-        framesRead = lovrSoundRead(source->sound, source->offset, MIN(chunk, capacity), raw);
+        framesRead = lovrSoundRead(source->sound, offset, MIN(chunk, capacity), raw);
       } else {
-        framesRead = lovrSoundRead(source->sound, source->offset, framesRemaining, cursor);
+        framesRead = lovrSoundRead(source->sound, offset, framesRemaining, cursor);
       }
 
       if (framesRead == 0) {
         if (source->looping) {
-          source->offset = 0;
+          offset = 0;
           continue;
         } else {
-          source->offset = 0;
-          source->playing = false;
+          offset = 0;
+          finished = true;
           memset(cursor, 0, framesRemaining * channelsOut * sizeof(float));
           break;
         }
       } else {
-        source->offset += framesRead;
+        offset += framesRead;
       }
 
       if (source->converter) {
@@ -141,6 +451,8 @@ static void onPlayback(ma_device* device, void* out, const void* in, uint32_t co
       }
     }
 
+    storeOffset(source, start, offset, finished);
+
     // Spatialize
     if (source->spatial) {
       state.spatializer->apply(source, buf, mix, BUFFER_SIZE, BUFFER_SIZE);
@@ -148,19 +460,28 @@ static void onPlayback(ma_device* device, void* out, const void* in, uint32_t co
     }
 
     // Mix
-    float volume = source->volume;
-    for (uint32_t i = 0; i < OUTPUT_CHANNELS * BUFFER_SIZE; i++) {
-      dst[i] += buf[i] * volume;
-    }
+    mixSamples(dst, buf, source->volume, OUTPUT_CHANNELS * BUFFER_SIZE);
   }
 
+  atomic_store(&state.activeVoices, mixed);
+  atomic_store(&state.virtualVoices, voiceCount - mixed);
+
   // Tail
-  uint32_t tailCount = state.spatializer->tail(aux, mix, BUFFER_SIZE);
-  for (uint32_t i = 0; i < tailCount * OUTPUT_CHANNELS; i++) {
-    dst[i] += mix[i];
+  if (spatialize) {
+    uint32_t tailCount = state.spatializer->tail(aux, mix, BUFFER_SIZE);
+    mixSamples(dst, mix, 1.f, tailCount * OUTPUT_CHANNELS);
+    unlockSpatializer();
   }
+}
 
-  ma_mutex_unlock(&state.lock);
+// Device callbacks
+
+static void onPlayback(ma_device* device, void* out, const void* in, uint32_t count) {
+  lovrAssert(count == BUFFER_SIZE, "Unreachable");
+  float aux[BUFFER_SIZE * 2];
+  float* dst = out;
+
+  mixSources(dst);
 
   if (state.sinks[AUDIO_PLAYBACK]) {
     uint64_t capacity = sizeof(aux) / lovrSoundGetChannelCount(state.sinks[AUDIO_PLAYBACK]) / sizeof(float);
@@ -201,8 +522,9 @@ bool lovrAudioInit(const char* spatializer, uint32_t sampleRate) {
   ma_result result = ma_context_init(NULL, 0, NULL, &state.context);
   lovrAssert(result == MA_SUCCESS, "Failed to initialize miniaudio");
 
-  result = ma_mutex_init(&state.lock);
-  lovrAssert(result == MA_SUCCESS, "Failed to create audio mutex");
+  for (uint32_t i = 0; i < MAX_COMMANDS; i++) {
+    atomic_init(&state.commands[i].sequence, i);
+  }
 
   for (size_t i = 0; i < COUNTOF(spatializers); i++) {
     if (spatializer && strcmp(spatializer, spatializers[i]->name)) {
@@ -220,6 +542,7 @@ bool lovrAudioInit(const char* spatializer, uint32_t sampleRate) {
   state.absorption[0] = .0002f;
   state.absorption[1] = .0017f;
   state.absorption[2] = .0182f;
+  memcpy(state.mixAbsorption, state.absorption, sizeof(state.absorption));
 
   quat_identity(state.orientation);
   return true;
@@ -231,9 +554,17 @@ void lovrAudioDestroy(void) {
     ma_device_uninit(&state.devices[i]);
     lovrFree(state.deviceInfo[i]);
   }
+  Command command;
+  while (popCommand(&command)) {
+    if (command.type == COMMAND_PLAY && command.source->index == ~0u) atomic_store(&command.source->reserved, false);
+    lovrRelease(command.source, lovrSourceDestroy);
+  }
   Source* source;
-  FOREACH_SOURCE(source) lovrRelease(source, lovrSourceDestroy);
-  ma_mutex_uninit(&state.lock);
+  FOREACH_SOURCE(source) {
+    source->index = ~0u;
+    atomic_store(&source->reserved, false);
+    lovrRelease(source, lovrSourceDestroy);
+  }
   ma_context_uninit(&state.context);
   lovrRelease(state.sinks[AUDIO_PLAYBACK], lovrSoundDestroy);
   lovrRelease(state.sinks[AUDIO_CAPTURE], lovrSoundDestroy);
@@ -358,6 +689,44 @@ bool lovrAudioIsStarted(AudioType type) {
   return ma_device_is_started(&state.devices[type]);
 }
 
+// Mixes without a device, as fast as possible.  Mixing happens in BUFFER_SIZE chunks, leftover
+// frames are kept for the next render so rendering in any size of chunk gives the same result.
+uint32_t lovrAudioRender(uint32_t frames, Sound* sound, uint32_t offset) {
+  lovrCheck(!ma_device_is_started(&state.devices[AUDIO_PLAYBACK]), "Audio can not be rendered while the playback device is started");
+  lovrCheck(lovrSoundGetFormat(sound) == OUTPUT_FORMAT, "Audio can only be rendered to f32 Sounds");
+  lovrCheck(lovrSoundGetChannelLayout(sound) == CHANNEL_STEREO, "Audio can only be rendered to stereo Sounds");
+  lovrCheck(lovrSoundGetSampleRate(sound) == state.sampleRate, "Sound sample rate must match the audio sample rate");
+
+  if (!lovrSoundIsStream(sound)) {
+    lovrCheck(offset <= lovrSoundGetFrameCount(sound), "Tried to render past the end of the Sound");
+    frames = MIN(frames, lovrSoundGetFrameCount(sound) - offset);
+  }
+
+  uint32_t written = 0;
+
+  while (written < frames) {
+    if (state.renderedCount == 0) {
+      memset(state.rendered, 0, sizeof(state.rendered));
+      mixSources(state.rendered);
+      state.renderedCount = BUFFER_SIZE;
+      state.renderedCursor = 0;
+    }
+
+    uint32_t chunk = MIN(frames - written, state.renderedCount);
+    uint32_t count = lovrSoundWrite(sound, offset + written, chunk, state.rendered + state.renderedCursor * OUTPUT_CHANNELS);
+    state.renderedCursor += count;
+    state.renderedCount -= count;
+    written += count;
+
+    // Stream is full
+    if (count < chunk) {
+      break;
+    }
+  }
+
+  return written;
+}
+
 float lovrAudioGetVolume(VolumeUnit units) {
   float volume = 0.f;
   ma_device_get_master_volume(&state.devices[AUDIO_PLAYBACK], &volume);
@@ -375,13 +744,15 @@ void lovrAudioGetPose(float position[3], float orientation[4]) {
 }
 
 void lovrAudioSetPose(float position[3], float orientation[4]) {
+  vec3_init(state.position, position);
+  quat_init(state.orientation, orientation);
   state.spatializer->setListenerPose(position, orientation);
 }
 
 bool lovrAudioSetGeometry(float* vertices, uint32_t* indices, uint32_t vertexCount, uint32_t indexCount, AudioMaterial material) {
-  ma_mutex_lock(&state.lock);
+  lockSpatializer();
   bool success = state.spatializer->setGeometry(vertices, indices, vertexCount, indexCount, material);
-  ma_mutex_unlock(&state.lock);
+  unlockSpatializer();
   return success;
 }
 
@@ -393,14 +764,24 @@ uint32_t lovrAudioGetSampleRate(void) {
   return state.sampleRate;
 }
 
+void lovrAudioGetVoiceCount(uint32_t* active, uint32_t* virtual) {
+  *active = atomic_load(&state.activeVoices);
+  *virtual = atomic_load(&state.virtualVoices);
+}
+
 void lovrAudioGetAbsorption(float absorption[3]) {
   memcpy(absorption, state.absorption, 3 * sizeof(float));
 }
 
 void lovrAudioSetAbsorption(float absorption[3]) {
-  ma_mutex_lock(&state.lock);
   memcpy(state.absorption, absorption, 3 * sizeof(float));
-  ma_mutex_unlock(&state.lock);
+  Command command = { .type = COMMAND_ABSORPTION };
+  memcpy(command.absorption, absorption, 3 * sizeof(float));
+  sendCommand(command);
+}
+
+void lovrAudioGetMixAbsorption(float absorption[3]) {
+  memcpy(absorption, state.mixAbsorption, 3 * sizeof(float));
 }
 
 // Source
@@ -485,30 +866,17 @@ Sound* lovrSourceGetSound(Source* source) {
 
 bool lovrSourcePlay(Source* source) {
   // If too many sources already running, refuse to play
-  if (state.sourceMask == ~0ull) {
+  if (!reserveSource(source)) {
     return false;
   }
 
-  ma_mutex_lock(&state.lock);
-
-  source->playing = true;
-
-  // If the source isn't tracked, set its index to the right-most zero bit in the mask
-  if (source->index == ~0u) {
-    uint32_t index = state.sourceMask ? CTZL(~state.sourceMask) : 0;
-    state.sourceMask |= (1ull << index);
-    state.sources[index] = source;
-    source->index = index;
-    lovrRetain(source);
-    state.spatializer->sourceCreate(source);
-  }
-
-  ma_mutex_unlock(&state.lock);
+  atomic_store(&source->playing, true);
+  sendCommand((Command) { .type = COMMAND_PLAY, .source = source });
   return true;
 }
 
 void lovrSourcePause(Source* source) {
-  source->playing = false;
+  atomic_store(&source->playing, false);
 }
 
 void lovrSourceStop(Source* source) {
@@ -517,7 +885,7 @@ void lovrSourceStop(Source* source) {
 }
 
 bool lovrSourceIsPlaying(Source* source) {
-  return source->playing;
+  return atomic_load(&source->playing);
 }
 
 bool lovrSourceIsLooping(Source* source) {
@@ -539,10 +907,8 @@ void lovrSourceSetPitch(Source* source, float pitch) {
 
   if (source->pitch != pitch) {
     source->pitch = pitch;
-    ma_mutex_lock(&state.lock);
     float ratio = (float) lovrSoundGetSampleRate(source->sound) / state.sampleRate;
-    ma_data_converter_set_rate_ratio(source->converter, pitch * ratio);
-    ma_mutex_unlock(&state.lock);
+    sendCommand((Command) { .type = COMMAND_PITCH, .source = source, .ratio = pitch * ratio });
   }
 }
 
@@ -556,13 +922,13 @@ void lovrSourceSetVolume(Source* source, float volume, VolumeUnit units) {
 }
 
 void lovrSourceSeek(Source* source, double time, TimeUnit units) {
-  ma_mutex_lock(&state.lock);
-  source->offset = units == UNIT_SECONDS ? (uint32_t) (time * lovrSoundGetSampleRate(source->sound) + .5) : (uint32_t) time;
-  ma_mutex_unlock(&state.lock);
+  uint32_t offset = units == UNIT_SECONDS ? (uint32_t) (time * lovrSoundGetSampleRate(source->sound) + .5) : (uint32_t) time;
+  atomic_store(&source->offset, offset);
 }
 
 double lovrSourceTell(Source* source, TimeUnit units) {
-  return units == UNIT_SECONDS ? (double) source->offset / lovrSoundGetSampleRate(source->sound) : source->offset;
+  uint32_t offset = atomic_load(&source->offset);
+  return units == UNIT_SECONDS ? (double) offset / lovrSoundGetSampleRate(source->sound) : offset;
 }
 
 double lovrSourceGetDuration(Source* source, TimeUnit units) {
@@ -579,11 +945,10 @@ void lovrSourceGetPose(Source* source, float position[3], float orientation[4])
   quat_init(orientation, source->orientation);
 }
 
+// The mixer may read a pose while it's being written, which is harmless for a single buffer
 void lovrSourceSetPose(Source* source, float position[3], float orientation[4]) {
-  ma_mutex_lock(&state.lock);
   if (position) vec3_init(source->position, position);
   if (orientation) quat_init(source->orientation, orientation);
-  ma_mutex_unlock(&state.lock);
 }
 
 float lovrSourceGetRadius(Source* source) {
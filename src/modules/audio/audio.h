@@ -5,7 +5,8 @@
 #pragma once
 
 #define BUFFER_SIZE 256
-#define MAX_SOURCES 64
+#define MAX_SOURCES 256
+#define MAX_VOICES 64
 
 struct Sound;
 
@@ -71,6 +72,7 @@ bool lovrAudioSetDevice(AudioType type, void* id, size_t size, struct Sound* sin
 bool lovrAudioStart(AudioType type);
 bool lovrAudioStop(AudioType type);
 bool lovrAudioIsStarted(AudioType type);
+uint32_t lovrAudioRender(uint32_t frames, struct Sound* sound, uint32_t offset);
 float lovrAudioGetVolume(VolumeUnit units);
 void lovrAudioSetVolume(float volume, VolumeUnit units);
 void lovrAudioGetPose(float position[3], float orientation[4]);
@@ -78,6 +80,7 @@ void lovrAudioSetPose(float position[3], float orientation[4]);
 bool lovrAudioSetGeometry(float* vertices, uint32_t* indices, uint32_t vertexCount, uint32_t indexCount, AudioMaterial material);
 const char* lovrAudioGetSpatializer(void);
 uint32_t lovrAudioGetSampleRate(void);
+void lovrAudioGetVoiceCount(uint32_t* active, uint32_t* virtual);
 void lovrAudioGetAbsorption(float absorption[3]);
 void lovrAudioSetAbsorption(float absorption[3]);
 
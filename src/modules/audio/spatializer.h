@@ -4,6 +4,9 @@
 intptr_t* lovrSourceGetSpatializerMemoField(Source* source);
 uint32_t lovrSourceGetIndex(Source* source);
 
+// The absorption the mixer is currently using, only call this from the mixer
+void lovrAudioGetMixAbsorption(float absorption[3]);
+
 typedef struct {
   bool (*init)(void);
   void (*destroy)(void);
@@ -223,7 +223,7 @@ uint32_t phonon_apply(Source* source, const float* input, float* output, uint32_
     .directivity.dipolePower = power
   };
 
-  lovrAudioGetAbsorption(iplSource.airAbsorptionModel.coefficients);
+  lovrAudioGetMixAbsorption(iplSource.airAbsorptionModel.coefficients);
 
   IPLDirectOcclusionMode occlusion = IPL_DIRECTOCCLUSION_NONE;
   IPLDirectOcclusionMethod volumetric = IPL_DIRECTOCCLUSION_RAYCAST;
@@ -19,7 +19,11 @@ Blob* lovrBlobCreate(void* data, size_t size, const char* name) {
 
 void lovrBlobDestroy(void* ref) {
   Blob* blob = ref;
-  lovrFree(blob->data);
+  if (blob->destructor) {
+    blob->destructor(blob);
+  } else {
+    lovrFree(blob->data);
+  }
   lovrFree(blob->name);
   lovrFree(blob);
 }
@@ -8,6 +8,8 @@ typedef struct Blob {
   void* data;
   size_t size;
   char* name;
+  void (*destructor)(struct Blob* blob);
+  void* context;
 } Blob;
 
 Blob* lovrBlobCreate(void* data, size_t size, const char* name);
@@ -208,6 +208,19 @@ static void setPixelR32F(float* src, ImagePointer dst) { for (uint32_t i = 0; i
 static void setPixelRG32F(float* src, ImagePointer dst) { for (uint32_t i = 0; i < 2; i++) dst.f32[i] = src[i]; }
 static void setPixelRGBA32F(float* src, ImagePointer dst) { for (uint32_t i = 0; i < 4; i++) dst.f32[i] = src[i]; }
 
+// Images that use a mapped Blob in place copy it before they are modified
+static void detach(Image* image) {
+  Blob* blob = image->blob;
+  if (!blob->destructor) return;
+  char* data = lovrMalloc(blob->size);
+  memcpy(data, blob->data, blob->size);
+  for (uint32_t i = 0; i < image->levels; i++) {
+    image->mipmaps[i].data = data + ((char*) image->mipmaps[i].data - (char*) blob->data);
+  }
+  image->blob = lovrBlobCreate(data, blob->size, blob->name);
+  lovrRelease(blob, lovrBlobDestroy);
+}
+
 void lovrImageGetPixel(Image* image, uint32_t x, uint32_t y, float pixel[4]) {
   lovrCheck(!lovrImageIsCompressed(image), "Unable to access individual pixels of a compressed image");
   lovrCheck(x < image->width && y < image->height, "Pixel coordinates must be within Image bounds");
@@ -230,6 +243,7 @@ void lovrImageGetPixel(Image* image, uint32_t x, uint32_t y, float pixel[4]) {
 void lovrImageSetPixel(Image* image, uint32_t x, uint32_t y, float pixel[4]) {
   lovrCheck(!lovrImageIsCompressed(image), "Unable to access individual pixels of a compressed image");
   lovrCheck(x < image->width && y < image->height, "Pixel coordinates must be within Image bounds");
+  detach(image);
   size_t offset = measure(y * image->width + x, 1, image->format);
   ImagePointer p = { .u8 = (uint8_t*) image->mipmaps[0].data + offset };
   switch (image->format) {
@@ -250,6 +264,7 @@ void lovrImageMapPixel(Image* image, uint32_t x0, uint32_t y0, uint32_t w, uint3
   lovrCheck(!lovrImageIsCompressed(image), "Unable to access individual pixels of a compressed image");
   lovrCheck(x0 + w <= image->width, "Pixel rectangle must be within Image bounds");
   lovrCheck(y0 + h <= image->height, "Pixel rectangle must be within Image bounds");
+  detach(image);
   void (*getPixel)(ImagePointer src, float* dst);
   void (*setPixel)(float* src, ImagePointer dst);
   switch (image->format) {
@@ -285,6 +300,7 @@ void lovrImageCopy(Image* src, Image* dst, uint32_t srcOffset[2], uint32_t dstOf
   lovrCheck(dstOffset[1] + extent[1] <= dst->height, "Image copy region extends past the destination image height");
   lovrCheck(srcOffset[0] + extent[0] <= src->width, "Image copy region extends past the source image width");
   lovrCheck(srcOffset[1] + extent[1] <= src->height, "Image copy region extends past the source image height");
+  detach(dst);
   size_t pixelSize = measure(1, 1, src->format);
   uint8_t* p = (uint8_t*) lovrImageGetLayerData(src, 0, 0) + (srcOffset[1] * src->width + srcOffset[0]) * pixelSize;
   uint8_t* q = (uint8_t*) lovrImageGetLayerData(dst, 0, 0) + (dstOffset[1] * dst->width + dstOffset[0]) * pixelSize;
@@ -2,7 +2,9 @@
 #include "data/blob.h"
 #include "data/image.h"
 #include "core/maf.h"
+#include "core/job.h"
 #include "util.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -115,6 +117,55 @@ void lovrModelDataAllocate(ModelData* model) {
   map_init(model->nodeMap, model->nodeCount);
 }
 
+typedef struct {
+  Blob* blob;
+  Image* image;
+  char* error;
+} ImageDecode;
+
+static void decodeImage(void* arg) {
+  ImageDecode* decode = arg;
+  decode->image = lovrImageCreateFromFile(decode->blob);
+}
+
+static void onDecodeError(void* arg, const char* format, va_list args) {
+  ImageDecode* decode = arg;
+  decode->error = lovrMalloc(1024);
+  vsnprintf(decode->error, 1024, format, args);
+}
+
+static void decodeImages(void* arg, uint32_t start, uint32_t count) {
+  ImageDecode* decodes = arg;
+  for (uint32_t i = start; i < start + count; i++) {
+    if (decodes[i].blob) {
+      lovrTry(decodeImage, &decodes[i], onDecodeError, &decodes[i]);
+    }
+  }
+}
+
+void lovrModelDataDecodeImages(Blob** blobs, Image** images, uint32_t count) {
+  if (count == 0) return;
+
+  ImageDecode* decodes = lovrCalloc(count * sizeof(ImageDecode));
+  for (uint32_t i = 0; i < count; i++) {
+    decodes[i].blob = blobs[i];
+  }
+
+  job_parallel_for(count, 1, decodeImages, decodes);
+
+  char error[1024] = { 0 };
+  for (uint32_t i = 0; i < count; i++) {
+    images[i] = decodes[i].image;
+    if (decodes[i].error) {
+      if (!error[0]) memcpy(error, decodes[i].error, sizeof(error));
+      lovrFree(decodes[i].error);
+    }
+  }
+
+  lovrFree(decodes);
+  lovrAssert(!error[0], "%s", error);
+}
+
 void lovrModelDataFinalize(ModelData* model) {
   for (uint32_t i = 0; i < model->primitiveCount; i++) {
     model->primitives[i].skin = ~0u;
@@ -163,26 +163,23 @@ static jsmntok_t* nomTexture(const char* json, jsmntok_t* token, uint32_t* image
   return token;
 }
 
-static void loadImage(ModelData* model, gltfImage* images, uint32_t index, ModelDataIO* io, char* filename, size_t maxLength) {
-  if (model->images[index]) {
+// Reads the encoded image into a Blob, decoding happens later for all images at once
+static void loadImage(Blob** blobs, ModelData* model, gltfImage* images, uint32_t index, ModelDataIO* io, char* filename, size_t maxLength) {
+  if (blobs[index]) {
     return;
   }
 
   gltfImage* image = &images[index];
   if (image->bufferView != ~0u) {
     ModelBuffer* buffer = &model->buffers[image->bufferView];
-    Blob* blob = lovrBlobCreate(buffer->data, buffer->size, NULL);
-    model->images[index] = lovrImageCreateFromFile(blob);
-    blob->data = NULL; // XXX Blob data ownership
-    lovrRelease(blob, lovrBlobDestroy);
+    blobs[index] = lovrBlobCreate(buffer->data, buffer->size, NULL);
   } else if (image->uri.data) {
     void* data;
-    Blob* blob;
     size_t size;
     if (image->uri.length >= 5 && !strncmp("data:", image->uri.data, 5)) {
       data = decodeBase64(image->uri.data, image->uri.length, &size);
       lovrAssert(data, "Could not decode base64 image");
-      blob = lovrBlobCreate(data, size, NULL);
+      blobs[index] = lovrBlobCreate(data, size, NULL);
     } else {
       char* path = image->uri.data;
       size_t length = image->uri.length;
@@ -192,13 +189,29 @@ static void loadImage(ModelData* model, gltfImage* images, uint32_t index, Model
       strncat(filename, path, length);
       data = io(filename, &size);
       lovrAssert(data && size > 0, "Unable to read image from '%s'", filename);
-      blob = lovrBlobCreate(data, size, NULL);
+      blobs[index] = lovrBlobCreate(data, size, NULL);
     }
-    model->images[index] = lovrImageCreateFromFile(blob);
-    lovrRelease(blob, lovrBlobDestroy);
   }
 }
 
+typedef struct {
+  Blob** blobs;
+  gltfImage* images;
+  uint32_t count;
+} ImageBlobs;
+
+// Runs through the defer stack, so the Blobs are also released if loading an image throws
+static void freeImageBlobs(void* arg) {
+  ImageBlobs* imageBlobs = arg;
+  for (uint32_t i = 0; i < imageBlobs->count; i++) {
+    if (imageBlobs->blobs[i] && imageBlobs->images[i].bufferView != ~0u) {
+      imageBlobs->blobs[i]->data = NULL; // XXX Blob data ownership
+    }
+    lovrRelease(imageBlobs->blobs[i], lovrBlobDestroy);
+  }
+  lovrFree(imageBlobs->blobs);
+}
+
 ModelData* lovrModelDataInitGltf(ModelData* model, Blob* source, ModelDataIO* io) {
   uint8_t* data = source->data;
   gltfHeader* header = (gltfHeader*) data;
@@ -727,6 +740,10 @@ ModelData* lovrModelDataInitGltf(ModelData* model, Blob* source, ModelDataIO* io
   }
 
   // Materials
+  Blob** imageBlobs = lovrCalloc(model->imageCount * sizeof(Blob*));
+  uint32_t defer = lovrDeferPush();
+  lovrDefer(freeImageBlobs, &(ImageBlobs) { imageBlobs, images, model->imageCount });
+
   if (model->materialCount > 0) {
     jsmntok_t* token = info.materials;
     ModelMaterial* material = model->materials;
@@ -765,7 +782,7 @@ ModelData* lovrModelDataInitGltf(ModelData* model, Blob* source, ModelDataIO* io
               material->color[3] = NOM_FLOAT(json, token);
             } else if (STR_EQ(key, "baseColorTexture")) {
               token = nomTexture(json, token, &material->texture, textures, material);
-              loadImage(model, images, material->texture, io, filename, maxPathLength);
+              loadImage(imageBlobs, model, images, material->texture, io, filename, maxPathLength);
               *root = '\0';
             } else if (STR_EQ(key, "metallicFactor")) {
               material->metalness = NOM_FLOAT(json, token);
@@ -773,7 +790,7 @@ ModelData* lovrModelDataInitGltf(ModelData* model, Blob* source, ModelDataIO* io
               material->roughness = NOM_FLOAT(json, token);
             } else if (STR_EQ(key, "metallicRoughnessTexture")) {
               token = nomTexture(json, token, &material->metalnessTexture, textures, NULL);
-              loadImage(model, images, material->metalnessTexture, io, filename, maxPathLength);
+              loadImage(imageBlobs, model, images, material->metalnessTexture, io, filename, maxPathLength);
               material->roughnessTexture = material->metalnessTexture;
               *root = '\0';
             } else {
@@ -782,15 +799,15 @@ ModelData* lovrModelDataInitGltf(ModelData* model, Blob* source, ModelDataIO* io
           }
         } else if (STR_EQ(key, "normalTexture")) {
           token = nomTexture(json, token, &material->normalTexture, textures, NULL);
-          loadImage(model, images, material->normalTexture, io, filename, maxPathLength);
+          loadImage(imageBlobs, model, images, material->normalTexture, io, filename, maxPathLength);
           *root = '\0';
         } else if (STR_EQ(key, "occlusionTexture")) {
           token = nomTexture(json, token, &material->occlusionTexture, textures, NULL);
-          loadImage(model, images, material->occlusionTexture, io, filename, maxPathLength);
+          loadImage(imageBlobs, model, images, material->occlusionTexture, io, filename, maxPathLength);
           *root = '\0';
         } else if (STR_EQ(key, "emissiveTexture")) {
           token = nomTexture(json, token, &material->glowTexture, textures, NULL);
-          loadImage(model, images, material->glowTexture, io, filename, maxPathLength);
+          loadImage(imageBlobs, model, images, material->glowTexture, io, filename, maxPathLength);
           *root = '\0';
         } else if (STR_EQ(key, "emissiveFactor")) {
           token++; // Enter array
@@ -812,6 +829,10 @@ ModelData* lovrModelDataInitGltf(ModelData* model, Blob* source, ModelDataIO* io
     }
   }
 
+  // Images are independent, so they are decoded in parallel
+  lovrModelDataDecodeImages(imageBlobs, model->images, model->imageCount);
+  lovrDeferPop(defer);
+
   // Primitives
   if (model->primitiveCount > 0) {
     gltfMesh* mesh = meshes;
@@ -13,7 +13,7 @@ typedef struct {
 } objGroup;
 
 typedef arr_t(ModelMaterial) arr_material_t;
-typedef arr_t(Image*) arr_image_t;
+typedef arr_t(Blob*) arr_blob_t;
 typedef arr_t(objGroup) arr_group_t;
 
 #define STARTS_WITH(a, b) !strncmp(a, b, strlen(b))
@@ -25,7 +25,7 @@ static uint32_t nomu32(char* s, char** end) {
   return n;
 }
 
-static void parseMtl(char* path, char* base, ModelDataIO* io, arr_image_t* images, arr_material_t* materials, map_t* names) {
+static void parseMtl(char* path, char* base, ModelDataIO* io, arr_blob_t* images, arr_material_t* materials, map_t* names) {
   size_t size = 0;
   char* p = io(path, &size);
   lovrAssert(p && size > 0, "Unable to read mtl from '%s'", path);
@@ -87,12 +87,10 @@ static void parseMtl(char* path, char* base, ModelDataIO* io, arr_image_t* image
       lovrAssert(pixels && imageSize > 0, "Unable to read image from %s", path);
       Blob* blob = lovrBlobCreate(pixels, imageSize, NULL);
 
-      Image* image = lovrImageCreateFromFile(blob);
       lovrAssert(materials->length > 0, "Tried to set a material property without declaring a material first");
       ModelMaterial* material = &materials->data[materials->length - 1];
       material->texture = (uint32_t) images->length;
-      arr_push(images, image);
-      lovrRelease(blob, lovrBlobDestroy);
+      arr_push(images, blob);
     }
 
     next:
@@ -113,7 +111,7 @@ ModelData* lovrModelDataInitObj(ModelData* model, Blob* source, ModelDataIO* io)
   size_t size = source->size;
 
   arr_group_t groups;
-  arr_image_t images;
+  arr_blob_t images;
   arr_material_t materials;
   arr_t(float) vertexBlob;
   arr_t(int) indexBlob;
@@ -298,7 +296,7 @@ ModelData* lovrModelDataInitObj(ModelData* model, Blob* source, ModelDataIO* io)
     .stride = sizeof(int)
   };
 
-  memcpy(model->images, images.data, model->imageCount * sizeof(Image*));
+  lovrModelDataDecodeImages(images.data, model->images, model->imageCount);
   memcpy(model->materials, materials.data, model->materialCount * sizeof(ModelMaterial));
   memcpy(((map_t*) model->materialMap)->hashes, materialMap.hashes, materialMap.size * sizeof(uint64_t));
   memcpy(((map_t*) model->materialMap)->values, materialMap.values, materialMap.size * sizeof(uint64_t));
@@ -382,6 +380,9 @@ ModelData* lovrModelDataInitObj(ModelData* model, Blob* source, ModelDataIO* io)
   };
 
 finish:
+  for (size_t i = 0; i < images.length; i++) {
+    lovrRelease(images.data[i], lovrBlobDestroy);
+  }
   arr_free(&groups);
   arr_free(&images);
   arr_free(&materials);
@@ -591,6 +591,15 @@ Image* lovrRasterizerGetAtlas(Rasterizer* rasterizer) {
   return rasterizer->atlas;
 }
 
+// Hash of the font file the rasterizer was created from (the default font has no Blob)
+uint64_t lovrRasterizerGetHash(Rasterizer* rasterizer) {
+  if (rasterizer->blob) {
+    return hash64(rasterizer->blob->data, rasterizer->blob->size);
+  } else {
+    return hash64(etc_VarelaRound_ttf, etc_VarelaRound_ttf_len);
+  }
+}
+
 uint32_t lovrRasterizerGetAtlasGlyph(Rasterizer* rasterizer, uint32_t index, uint16_t* x, uint16_t* y) {
   if (rasterizer->type == RASTERIZER_TTF || index >= rasterizer->glyphs.length) {
     return 0;
@@ -1,4 +1,5 @@
 #include "filesystem/filesystem.h"
+#include "data/blob.h"
 #include "event/event.h"
 #include "core/fs.h"
 #include "core/os.h"
@@ -21,7 +22,7 @@ typedef struct {
   uint32_t firstChild;
   uint32_t nextSibling;
   const char* filename;
-  const void* data;
+  uint64_t offset;
   uint32_t compressedSize;
   uint32_t uncompressedSize;
   uint16_t filenameLength;
@@ -31,18 +32,33 @@ typedef struct {
   bool compressed;
 } zip_node;
 
+// Inflate state saved at regular intervals so seeks can resume from the nearest one.  Each one is
+// ~43KB, so they're only made once a handle seeks backwards and they're spread out for big files.
+#define ZIP_CHECKPOINT_SPACING (1 << 20)
+#define ZIP_CHECKPOINT_MAX 64
+
+typedef struct {
+  size_t inputCursor;
+  size_t outputCursor;
+  uint8_t buffer[TINFL_LZ_DICT_SIZE];
+  tinfl_decompressor decompressor;
+} zip_checkpoint;
+
 typedef struct {
   size_t inputCursor;
   size_t outputCursor;
   size_t bufferExtent;
-  uint8_t buffer[32768];
+  uint8_t buffer[TINFL_LZ_DICT_SIZE];
   tinfl_decompressor decompressor;
+  arr_t(zip_checkpoint) checkpoints;
+  size_t checkpointSpacing;
 } zip_stream;
 
 typedef struct {
   fs_handle file;
   zip_node* node;
   zip_stream* stream;
+  const uint8_t* data;
   uint64_t offset;
 } Handle;
 
@@ -54,12 +70,14 @@ struct Archive {
   bool (*read)(Archive* archive, Handle* handle, uint8_t* data, size_t size, size_t* count);
   bool (*seek)(Archive* archive, Handle* handle, uint64_t offset);
   bool (*fsize)(Archive* archive, Handle* handle, uint64_t* size);
+  bool (*map)(Archive* archive, const char* path, void** data, size_t* size);
   bool (*stat)(Archive* archive, const char* path, FileInfo* info, bool needTime);
   void (*list)(Archive* archive, const char* path, fs_list_cb callback, void* context);
   char* path;
   char* mountpoint;
   size_t pathLength;
   size_t mountLength;
+  double mountTime;
   uint8_t* data;
   size_t size;
   map_t lookup;
@@ -254,8 +272,12 @@ bool lovrFilesystemMount(const char* path, const char* mountpoint, bool append,
     }
   }
 
+  lovrProfileStart(zone, "lovrFilesystemMount");
+  double start = os_get_time();
   Archive* archive = lovrArchiveCreate(path, mountpoint, root);
+  lovrProfileEnd(zone);
   if (!archive) return false;
+  archive->mountTime = os_get_time() - start;
 
   if (append) {
     Archive* list = state.archives;
@@ -312,6 +334,15 @@ static Archive* archiveStat(const char* p, FileInfo* info, bool needTime) {
   return NULL;
 }
 
+double lovrFilesystemGetMountTime(const char* path) {
+  FOREACH_ARCHIVE(archive) {
+    if (!strcmp(archive->path, path)) {
+      return archive->mountTime;
+    }
+  }
+  return -1.;
+}
+
 const char* lovrFilesystemGetRealDirectory(const char* path) {
   FileInfo info;
   Archive* archive = archiveStat(path, &info, false);
@@ -338,35 +369,86 @@ uint64_t lovrFilesystemGetLastModified(const char* path) {
   return archiveStat(path, &info, true) ? info.lastModified : ~0ull;
 }
 
-void* lovrFilesystemRead(const char* p, size_t* size) {
+static void* archiveRead(Archive* archive, const char* path, size_t* size) {
   Handle handle;
+  if (!archive->open(archive, path, &handle)) {
+    return NULL;
+  }
+
+  uint64_t bytes;
+  if (!archive->fsize(archive, &handle, &bytes) || bytes > SIZE_MAX) {
+    archive->close(archive, &handle);
+    return NULL;
+  }
+
+  *size = (size_t) bytes;
+  void* data = lovrMalloc(*size);
+
+  if (!archive->read(archive, &handle, data, *size, size)) {
+    archive->close(archive, &handle);
+    lovrFree(data);
+    return NULL;
+  }
+
+  archive->close(archive, &handle);
+  return data;
+}
+
+void* lovrFilesystemRead(const char* p, size_t* size) {
   char path[1024];
   size_t length = sizeof(path);
   if (sanitize(p, path, &length)) {
     FOREACH_ARCHIVE(archive) {
-      if (!archiveContains(archive, path, length)) {
-        continue;
+      if (archiveContains(archive, path, length)) {
+        void* data = archiveRead(archive, path, size);
+        if (data) return data;
       }
+    }
+  }
+  return NULL;
+}
 
-      if (!archive->open(archive, path, &handle)) {
-        continue;
-      }
+static void unmapFile(Blob* blob) {
+  fs_unmap(blob->data, blob->size);
+}
+
+static void unmapArchive(Blob* blob) {
+  lovrRelease(blob->context, lovrArchiveDestroy);
+}
 
-      uint64_t bytes;
-      if (!archive->fsize(archive, &handle, &bytes) || bytes > SIZE_MAX) {
-        archive->close(archive, &handle);
+static bool isSaveArchive(Archive* archive) {
+  return state.savePathLength > 0 && archive->pathLength == state.savePathLength && !memcmp(archive->path, state.savePath, state.savePathLength);
+}
+
+// Mapped Blobs are read-only and only stay valid while the file is intact, so files in the save
+// directory (which lovr.filesystem.write can truncate) are always read into memory instead
+Blob* lovrFilesystemMap(const char* p) {
+  char path[1024];
+  size_t length = sizeof(path);
+  if (sanitize(p, path, &length)) {
+    FOREACH_ARCHIVE(archive) {
+      if (!archiveContains(archive, path, length)) {
         continue;
       }
 
-      *size = (size_t) bytes;
-      void* data = lovrMalloc(*size);
-
-      if (archive->read(archive, &handle, data, *size, size)) {
-        archive->close(archive, &handle);
-        return data;
+      void* data;
+      size_t size;
+      if (!isSaveArchive(archive) && archive->map(archive, path, &data, &size)) {
+        Blob* blob = lovrBlobCreate(data, size, p);
+        if (archive->data) {
+          blob->destructor = unmapArchive;
+          blob->context = archive;
+          lovrRetain(archive);
+        } else {
+          blob->destructor = unmapFile;
+        }
+        return blob;
       }
 
-      archive->close(archive, &handle);
+      // Compressed entries and empty files can't be mapped, so they get read into memory instead
+      if ((data = archiveRead(archive, path, &size)) != NULL) {
+        return lovrBlobCreate(data, size, p);
+      }
     }
   }
   return NULL;
@@ -588,6 +670,16 @@ static bool dir_fsize(Archive* archive, Handle* handle, uint64_t* size) {
   }
 }
 
+static bool dir_map(Archive* archive, const char* path, void** data, size_t* size) {
+  char resolved[LOVR_PATH_MAX];
+  FileInfo info;
+  if (!dir_resolve(archive, path, resolved) || !fs_stat(resolved, &info) || info.type != FILE_REGULAR || info.size == 0) {
+    return false;
+  }
+  *data = fs_map(resolved, size);
+  return *data != NULL;
+}
+
 static bool dir_stat(Archive* archive, const char* path, FileInfo* info, bool needTime) {
   char resolved[LOVR_PATH_MAX];
   return dir_resolve(archive, path, resolved) && fs_stat(resolved, info);
@@ -696,23 +788,8 @@ static bool zip_init(Archive* archive, const char* filename, const char* root) {
     const char* path = (const char*) (p + 46);
     cursor += 46 + readu16(p + 28) + readu16(p + 30) + readu16(p + 32);
 
-    // Sanity check the local file header
-    uint64_t headerOffset = base + readu32(p + 42);
-    uint8_t* header = archive->data + headerOffset;
-    if (headerOffset > archive->size - 30 || readu32(header) != 0x04034b50) {
-      zip_free(archive);
-      return false;
-    }
-
-    // Filename and extra data are 30 bytes after the header, then the data starts
-    uint64_t dataOffset = headerOffset + 30 + readu16(header + 26) + readu16(header + 28);
-    node.data = archive->data + dataOffset;
-
-    // Make sure data is actually contained in the zip
-    if (dataOffset + node.compressedSize > archive->size) {
-      zip_free(archive);
-      return false;
-    }
+    // The local file header is checked when the file is opened
+    node.offset = base + readu32(p + 42);
 
     // Strip leading slashes
     while (length > 0 && *path == '/') {
@@ -779,6 +856,24 @@ static bool zip_init(Archive* archive, const char* filename, const char* root) {
   return true;
 }
 
+// Reading local file headers lazily keeps mounts from touching every page of the archive
+static const uint8_t* zip_data(Archive* archive, zip_node* node) {
+  uint8_t* header = archive->data + node->offset;
+  if (node->offset + 30 > archive->size || readu32(header) != 0x04034b50) {
+    return NULL;
+  }
+
+  // Filename and extra data are 30 bytes after the header, then the data starts
+  uint64_t dataOffset = node->offset + 30 + readu16(header + 26) + readu16(header + 28);
+
+  // Make sure data is actually contained in the zip
+  if (dataOffset + node->compressedSize > archive->size) {
+    return NULL;
+  }
+
+  return archive->data + dataOffset;
+}
+
 static zip_node* zip_resolve(Archive* archive, const char* fulpathLength) {
   const char* path = fulpathLength + (archive->mountLength ? archive->mountLength + 1 : 0);
   size_t length = strlen(path);
@@ -795,12 +890,20 @@ static bool zip_open(Archive* archive, const char* path, Handle* handle) {
     return false;
   }
 
+  handle->data = zip_data(archive, handle->node);
+
+  if (!handle->data) {
+    return false;
+  }
+
   if (handle->node->compressed) {
     zip_stream* stream = handle->stream = lovrMalloc(sizeof(zip_stream));
     tinfl_init(&stream->decompressor);
     stream->inputCursor = 0;
     stream->outputCursor = 0;
     stream->bufferExtent = 0;
+    arr_init(&stream->checkpoints);
+    stream->checkpointSpacing = 0;
   } else {
     handle->stream = NULL;
   }
@@ -810,23 +913,42 @@ static bool zip_open(Archive* archive, const char* path, Handle* handle) {
 }
 
 static bool zip_close(Archive* archive, Handle* handle) {
+  if (handle->stream) arr_free(&handle->stream->checkpoints);
   lovrFree(handle->stream);
   return true;
 }
 
-static bool decompress(zip_node* node, zip_stream* stream, uint8_t* data, size_t size, size_t* count) {
+static bool decompress(Handle* handle, uint8_t* data, size_t size, size_t* count) {
+  zip_node* node = handle->node;
+  zip_stream* stream = handle->stream;
+
   if (size > 0 && stream->bufferExtent > 0) {
     lovrUnreachable(); // Data in the buffer must be copied out first!
   }
 
   while (size > 0) {
-    uint8_t* input = (uint8_t*) node->data + stream->inputCursor;
+    uint8_t* input = (uint8_t*) handle->data + stream->inputCursor;
     uint8_t* output = stream->buffer;
     size_t inSize = node->compressedSize - stream->inputCursor;
     size_t outSize = sizeof(stream->buffer);
     uint32_t flags = stream->outputCursor + outSize < node->uncompressedSize ? TINFL_FLAG_HAS_MORE_INPUT : 0;
     int status = tinfl_decompress(&stream->decompressor, input, &inSize, output, output, &outSize, flags);
     if (status < 0) return false;
+
+    // The buffer holds the whole dictionary after a full inflate, which makes it a place to resume
+    bool full = outSize == sizeof(stream->buffer) && status == TINFL_STATUS_HAS_MORE_OUTPUT;
+    size_t spacing = stream->checkpointSpacing;
+    size_t length = stream->checkpoints.length;
+    size_t next = length > 0 ? stream->checkpoints.data[length - 1].outputCursor + spacing : spacing;
+    if (full && spacing > 0 && length < ZIP_CHECKPOINT_MAX && stream->outputCursor >= next) {
+      arr_expand(&stream->checkpoints, 1);
+      zip_checkpoint* checkpoint = &stream->checkpoints.data[stream->checkpoints.length++];
+      checkpoint->inputCursor = stream->inputCursor + inSize;
+      checkpoint->outputCursor = stream->outputCursor;
+      memcpy(checkpoint->buffer, stream->buffer, sizeof(stream->buffer));
+      checkpoint->decompressor = stream->decompressor;
+    }
+
     size_t n = MIN(outSize, size);
     if (data) memcpy(data, stream->buffer, n), data += n;
     stream->inputCursor += inSize;
@@ -852,7 +974,7 @@ static bool zip_read(Archive* archive, Handle* handle, uint8_t* data, size_t siz
   // Uncompressed reads are a simple memcpy
   if (!node->compressed) {
     *count = MIN(size, node->uncompressedSize - handle->offset);
-    memcpy(data, (char*) node->data + handle->offset, *count);
+    memcpy(data, handle->data + handle->offset, *count);
     handle->offset += *count;
     return true;
   }
@@ -861,7 +983,7 @@ static bool zip_read(Archive* archive, Handle* handle, uint8_t* data, size_t siz
   if (handle->offset == 0 && size == node->uncompressedSize) {
     size_t inputSize = node->compressedSize;
     uint32_t flags = TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF;
-    int status = tinfl_decompress(&stream->decompressor, node->data, &inputSize, data, data, &size, flags);
+    int status = tinfl_decompress(&stream->decompressor, handle->data, &inputSize, data, data, &size, flags);
     if (status != TINFL_STATUS_DONE) return false;
     stream->outputCursor = size;
     handle->offset = size;
@@ -869,8 +991,27 @@ static bool zip_read(Archive* archive, Handle* handle, uint8_t* data, size_t siz
     return true;
   }
 
-  // If the file seeked backwards, gotta rewind to the beginning
-  if (stream->outputCursor > handle->offset) {
+  // The first backwards seek starts recording checkpoints
+  if (stream->outputCursor > handle->offset && stream->checkpointSpacing == 0) {
+    size_t spacing = node->uncompressedSize / ZIP_CHECKPOINT_MAX;
+    stream->checkpointSpacing = MAX(spacing, ZIP_CHECKPOINT_SPACING);
+  }
+
+  // Seeking backwards, or forwards past a checkpoint, resumes from the closest checkpoint
+  // If the file seeked backwards before the first checkpoint, gotta rewind to the beginning
+  zip_checkpoint* checkpoint = NULL;
+  for (size_t i = 0; i < stream->checkpoints.length; i++) {
+    if (stream->checkpoints.data[i].outputCursor > handle->offset) break;
+    checkpoint = &stream->checkpoints.data[i];
+  }
+
+  if (checkpoint && (stream->outputCursor > handle->offset || checkpoint->outputCursor > stream->outputCursor)) {
+    stream->decompressor = checkpoint->decompressor;
+    memcpy(stream->buffer, checkpoint->buffer, sizeof(stream->buffer));
+    stream->inputCursor = checkpoint->inputCursor;
+    stream->outputCursor = checkpoint->outputCursor;
+    stream->bufferExtent = sizeof(stream->buffer);
+  } else if (stream->outputCursor > handle->offset) {
     tinfl_init(&stream->decompressor);
     stream->inputCursor = 0;
     stream->outputCursor = 0;
@@ -885,7 +1026,7 @@ static bool zip_read(Archive* archive, Handle* handle, uint8_t* data, size_t siz
       stream->bufferExtent -= n;
     }
 
-    if (!decompress(node, stream, NULL, handle->offset - stream->outputCursor, NULL)) {
+    if (!decompress(handle, NULL, handle->offset - stream->outputCursor, NULL)) {
       return false;
     }
   }
@@ -907,7 +1048,7 @@ static bool zip_read(Archive* archive, Handle* handle, uint8_t* data, size_t siz
   }
 
   // Finally, decompress data in chunks and copy to the output until finished
-  if (decompress(node, stream, data, size, count)) {
+  if (decompress(handle, data, size, count)) {
     handle->offset += size;
     return true;
   }
@@ -926,6 +1067,18 @@ static bool zip_fsize(Archive* archive, Handle* handle, uint64_t* size) {
   return true;
 }
 
+// Stored entries are used in place from the mapped archive
+static bool zip_map(Archive* archive, const char* path, void** data, size_t* size) {
+  zip_node* node = zip_resolve(archive, path);
+  if (!node || node->directory || node->compressed || node->uncompressedSize == 0) {
+    return false;
+  }
+  *data = (void*) zip_data(archive, node);
+  if (!*data) return false;
+  *size = node->uncompressedSize;
+  return true;
+}
+
 static bool zip_stat(Archive* archive, const char* path, FileInfo* info, bool needTime) {
   zip_node* node = zip_resolve(archive, path);
   if (!node) return false;
@@ -973,6 +1126,7 @@ Archive* lovrArchiveCreate(const char* path, const char* mountpoint, const char*
     archive->read = dir_read;
     archive->seek = dir_seek;
     archive->fsize = dir_fsize;
+    archive->map = dir_map;
     archive->stat = dir_stat;
     archive->list = dir_list;
   } else if (zip_init(archive, path, root)) {
@@ -981,6 +1135,7 @@ Archive* lovrArchiveCreate(const char* path, const char* mountpoint, const char*
     archive->read = zip_read;
     archive->seek = zip_seek;
     archive->fsize = zip_fsize;
+    archive->map = zip_map;
     archive->stat = zip_stat;
     archive->list = zip_list;
   } else {
@@ -6,6 +6,8 @@
 
 #define LOVR_PATH_MAX 1024
 
+struct Blob;
+
 typedef struct Archive Archive;
 typedef struct File File;
 
@@ -25,12 +27,14 @@ void lovrFilesystemWatch(void);
 void lovrFilesystemUnwatch(void);
 bool lovrFilesystemMount(const char* path, const char* mountpoint, bool append, const char *root);
 bool lovrFilesystemUnmount(const char* path);
+double lovrFilesystemGetMountTime(const char* path);
 const char* lovrFilesystemGetRealDirectory(const char* path);
 bool lovrFilesystemIsFile(const char* path);
 bool lovrFilesystemIsDirectory(const char* path);
 uint64_t lovrFilesystemGetSize(const char* path);
 uint64_t lovrFilesystemGetLastModified(const char* path);
 void* lovrFilesystemRead(const char* path, size_t* size);
+struct Blob* lovrFilesystemMap(const char* path);
 void lovrFilesystemGetDirectoryItems(const char* path, void (*callback)(void* context, const char* path), void* context);
 const char* lovrFilesystemGetIdentity(void);
 bool lovrFilesystemSetIdentity(const char* identity, bool precedence);
@@ -7,6 +7,7 @@
 #include "headset/headset.h"
 #include "math/math.h"
 #include "core/gpu.h"
+#include "core/job.h"
 #include "core/maf.h"
 #include "core/spv.h"
 #include "core/os.h"
@@ -19,6 +20,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <threads.h>
 #ifdef LOVR_USE_GLSLANG
 #include "glslang_c_interface.h"
 #include "resource_limits_c.h"
@@ -30,9 +32,17 @@
 #define PIPELINE_STACK_SIZE 4
 #define MAX_SHADER_RESOURCES 32
 #define MAX_CUSTOM_ATTRIBUTES 10
+#define MAX_TEXT_GLYPHS 16384
+#define TEXT_CACHE_LIFETIME 60
+#define TEXT_SIGHTING_COUNT 64
 #define LAYOUT_BUILTINS 0
 #define LAYOUT_MATERIAL 1
 #define LAYOUT_UNIFORMS 2
+#define SPIRV_CACHE_MAGIC 0x5650534c
+#define FONT_CACHE_MAGIC 0x544e4f46
+#define FONT_CACHE_VERSION 2
+#define FONT_PAGE_SIZE 1024
+#define PIPELINE_PENDING (1ull << 32)
 #define FLOAT_BITS(f) ((union { float f; uint32_t u; }) { f }).u
 
 typedef struct {
@@ -119,9 +129,19 @@ typedef struct {
   uint32_t hash;
 } ShaderAttribute;
 
+typedef struct {
+  ShaderSource sources[2];
+  ShaderSource outputs[2];
+  ShaderFlag* flags;
+  ShaderIncluder* io;
+  char* error;
+} ShaderCompile;
+
 struct Shader {
   uint32_t ref;
   Shader* parent;
+  ShaderCompile* compile;
+  job_group jobs;
   gpu_shader* gpu;
   gpu_pipeline* computePipeline;
   ShaderInfo info;
@@ -160,27 +180,54 @@ struct Material {
 };
 
 typedef struct {
+  uint32_t codepoint;
   float advance;
   uint16_t x, y;
+  uint16_t page;
   uint16_t uv[4];
   float box[4];
 } Glyph;
 
+typedef struct {
+  uint32_t x;
+  uint32_t y;
+  uint32_t width;
+} SkylineNode;
+
+typedef struct {
+  Texture* texture;
+  Material* material;
+  arr_t(SkylineNode) skyline;
+  uint32_t tick;
+} FontPage;
+
+// Laid out text, only cached once the same text is drawn a second time
+typedef struct {
+  uint64_t hash;
+  Buffer* vertices;
+  GlyphBatch* batches;
+  uint32_t batchCount;
+  uint32_t glyphCount;
+  uint32_t lineCount;
+  uint32_t tick;
+} CachedText;
+
 struct Font {
   uint32_t ref;
   FontInfo info;
-  Material* material;
   arr_t(Glyph) glyphs;
   map_t glyphLookup;
   float pixelDensity;
   float lineSpacing;
   uint32_t padding;
-  Texture* atlas;
-  uint32_t atlasWidth;
-  uint32_t atlasHeight;
-  uint32_t rowHeight;
-  uint32_t atlasX;
-  uint32_t atlasY;
+  FontPage pages[MAX_FONT_PAGES];
+  uint32_t pageCount;
+  uint32_t pageWidth;
+  uint32_t pageHeight;
+  arr_t(CachedText) texts;
+  map_t textLookup;
+  uint32_t textTick;
+  uint64_t textSightings[TEXT_SIGHTING_COUNT];
 };
 
 struct Mesh {
@@ -246,6 +293,13 @@ typedef struct {
   float scale[3];
 } NodeTransform;
 
+struct Pose {
+  uint32_t ref;
+  ModelData* data;
+  NodeTransform* transforms;
+  float* weights;
+};
+
 typedef struct {
   uint32_t index;
   uint32_t count;
@@ -253,9 +307,18 @@ typedef struct {
   uint32_t vertexCount;
 } BlendGroup;
 
+typedef struct {
+  Blob* blob;
+  ModelDataIO* io;
+  ModelData* data;
+  char* error;
+} ModelLoad;
+
 struct Model {
   uint32_t ref;
   Model* parent;
+  ModelLoad* load;
+  job_group jobs;
   ModelInfo info;
   DrawInfo* draws;
   Buffer* rawVertexBuffer;
@@ -271,10 +334,12 @@ struct Model {
   float* boundingBoxes;
   bool transformsDirty;
   bool blendShapesDirty;
+  bool skinDirty;
   float* blendShapeWeights;
   BlendGroup* blendGroups;
   uint32_t blendGroupCount;
   uint32_t lastVertexAnimation;
+  uint32_t animationInterval;
 };
 
 typedef enum {
@@ -428,6 +493,7 @@ typedef struct {
   DrawMode mode;
   float color[4];
   Buffer* lastVertexBuffer;
+  Shader* lastVertexShader;
   VertexFormat lastVertexFormat;
   gpu_pipeline_info info;
   Material* material;
@@ -536,6 +602,8 @@ struct Pass {
   uint32_t drawCapacity;
   Draw* draws;
   PassStats stats;
+  bool sorting;
+  bool batching;
 };
 
 typedef struct {
@@ -568,6 +636,62 @@ typedef struct {
   uint32_t tick;
 } ScratchTexture;
 
+// Holds a reference to the Shader, since info.shader borrows it.  info.pass is safe to borrow
+// because render passes are cached until the graphics module is destroyed.
+typedef struct {
+  uint64_t hash;
+  uint32_t index;
+  bool failed;
+  Shader* shader;
+  gpu_pipeline_info info;
+} PipelineWarmup;
+
+// Vertex animation dispatches are queued when models are drawn and recorded together at submit
+typedef struct {
+  Model* model;
+  gpu_bundle* bundle;
+  uint32_t constants[5];
+  uint32_t workgroups;
+  bool skin;
+} VertexAnimation;
+
+typedef struct {
+  uint32_t magic;
+  uint32_t count;
+  uint64_t version;
+} SpirvCacheHeader;
+
+// Followed by the glyphs, the skyline of each page (node count and nodes), and the RGBA8 pages
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t fingerprint;
+  uint32_t pageWidth;
+  uint32_t pageHeight;
+  uint32_t pageCount;
+  uint32_t glyphCount;
+} FontCacheHeader;
+
+// Followed by the includes (path hash, length, and padded path) and then the stages
+typedef struct {
+  uint64_t key;
+  uint32_t size;
+  uint32_t includeCount;
+  uint32_t stageCount;
+  uint32_t padding;
+} SpirvCacheEntry;
+
+typedef struct {
+  uint64_t hash;
+  uint32_t length;
+  uint32_t padding;
+} SpirvCacheInclude;
+
+typedef struct {
+  uint32_t stage;
+  uint32_t size;
+} SpirvCacheStage;
+
 static struct {
   uint32_t ref;
   bool active;
@@ -590,6 +714,7 @@ static struct {
   Pass* windowPass;
   Font* defaultFont;
   Buffer* defaultBuffer;
+  Buffer* quadIndices;
   Texture* defaultTexture;
   Sampler* defaultSamplers[2];
   Shader* defaultShaders[DEFAULT_SHADER_COUNT];
@@ -605,7 +730,15 @@ static struct {
   map_t pipelineLookup;
   gpu_pipeline* pipelines;
   uint32_t pipelineCount;
+  job_group warmup;
+  arr_t(PipelineWarmup*) warmups;
+  arr_t(VertexAnimation) animations;
   arr_t(Layout) layouts;
+  mtx_t spirvLock;
+  map_t spirvLookup;
+  arr_t(char) spirvCache;
+  uint64_t spirvVersion;
+  bool spirvDirty;
   Allocator allocator;
 } state;
 
@@ -615,6 +748,7 @@ static void* tempAlloc(Allocator* allocator, size_t size);
 static size_t tempPush(Allocator* allocator);
 static void tempPop(Allocator* allocator, size_t stack);
 static gpu_pipeline* getPipeline(uint32_t index);
+static void finishWarmup(void);
 static BufferBlock* getBlock(gpu_buffer_type type, uint32_t size);
 static void freeBlock(BufferAllocator* allocator, BufferBlock* block);
 static BufferView allocateBuffer(BufferAllocator* allocator, gpu_buffer_type type, uint32_t size, size_t align);
@@ -641,7 +775,9 @@ static void trackMaterial(Pass* pass, Material* material);
 static bool syncResource(Access* access, gpu_barrier* barrier);
 static gpu_barrier syncTransfer(Sync* sync, gpu_phase phase, gpu_cache cache);
 static void updateModelTransforms(Model* model, uint32_t nodeIndex, float* parent);
+static void flushAnimations(void);
 static void checkShaderFeatures(uint32_t* features, uint32_t count);
+static void loadSpirvCache(void* data, size_t size);
 static void onResize(uint32_t width, uint32_t height);
 static void onMessage(void* context, const char* message, bool severe);
 
@@ -689,10 +825,19 @@ bool lovrGraphicsInit(GraphicsConfig* config) {
 
   map_init(&state.passLookup, 4);
   map_init(&state.pipelineLookup, 64);
+  arr_init(&state.warmups);
+  arr_init(&state.animations);
   arr_init(&state.layouts);
   arr_init(&state.materialBlocks);
   arr_init(&state.scratchTextures);
 
+  mtx_init(&state.spirvLock, mtx_plain);
+  map_init(&state.spirvLookup, 64);
+  arr_init(&state.spirvCache);
+  uint64_t version[] = { LOVR_VERSION_MAJOR, LOVR_VERSION_MINOR, LOVR_VERSION_PATCH, hash64(etc_shaders_lovr_glsl, etc_shaders_lovr_glsl_len) };
+  state.spirvVersion = hash64(version, sizeof(version));
+  loadSpirvCache(config->spirvCacheData, config->spirvCacheSize);
+
   gpu_slot builtinSlots[] = {
     { 0, GPU_SLOT_UNIFORM_BUFFER, GPU_STAGE_GRAPHICS }, // Globals
     { 1, GPU_SLOT_UNIFORM_BUFFER_DYNAMIC, GPU_STAGE_GRAPHICS }, // Cameras
@@ -860,6 +1005,7 @@ void lovrGraphicsDestroy(void) {
   lovrRelease(state.windowPass, lovrPassDestroy);
   lovrRelease(state.defaultFont, lovrFontDestroy);
   lovrRelease(state.defaultBuffer, lovrBufferDestroy);
+  lovrRelease(state.quadIndices, lovrBufferDestroy);
   lovrRelease(state.defaultTexture, lovrTextureDestroy);
   lovrRelease(state.defaultSamplers[0], lovrSamplerDestroy);
   lovrRelease(state.defaultSamplers[1], lovrSamplerDestroy);
@@ -884,6 +1030,12 @@ void lovrGraphicsDestroy(void) {
     lovrFree(state.scratchTextures.data[i].texture);
   }
   arr_free(&state.scratchTextures);
+  finishWarmup();
+  arr_free(&state.warmups);
+  for (size_t i = 0; i < state.animations.length; i++) {
+    lovrRelease(state.animations.data[i].model, lovrModelDestroy);
+  }
+  arr_free(&state.animations);
   for (size_t i = 0; i < state.pipelineCount; i++) {
     gpu_pipeline_destroy(getPipeline(i));
   }
@@ -927,6 +1079,9 @@ void lovrGraphicsDestroy(void) {
     lovrFree(state.layouts.data[i].gpu);
   }
   arr_free(&state.layouts);
+  map_free(&state.spirvLookup);
+  arr_free(&state.spirvCache);
+  mtx_destroy(&state.spirvLock);
   gpu_destroy();
 #ifdef LOVR_USE_GLSLANG
   glslang_finalize_process();
@@ -1015,6 +1170,48 @@ void lovrGraphicsGetShaderCache(void* data, size_t* size) {
   gpu_pipeline_get_cache(data, size);
 }
 
+// Whether any shaders were compiled since the cache was loaded
+bool lovrGraphicsIsSpirvCacheDirty(void) {
+  mtx_lock(&state.spirvLock);
+  bool dirty = state.spirvDirty;
+  mtx_unlock(&state.spirvLock);
+  return dirty;
+}
+
+void lovrGraphicsGetSpirvCache(void* data, size_t* size) {
+  mtx_lock(&state.spirvLock);
+
+  if (!data) {
+    *size = sizeof(SpirvCacheHeader) + state.spirvCache.length;
+    mtx_unlock(&state.spirvLock);
+    return;
+  }
+
+  // Only whole entries are copied, in case more shaders were compiled since the size was queried
+  SpirvCacheHeader* header = data;
+  char* cursor = (char*) (header + 1);
+  size_t offset = 0;
+  uint32_t count = 0;
+
+  while (offset < state.spirvCache.length) {
+    SpirvCacheEntry* entry = (SpirvCacheEntry*) (state.spirvCache.data + offset);
+    if ((size_t) (cursor - (char*) data) + entry->size > *size) break;
+    if (map_get(&state.spirvLookup, entry->key) == offset) {
+      memcpy(cursor, entry, entry->size);
+      cursor += entry->size;
+      count++;
+    }
+    offset += entry->size;
+  }
+
+  header->magic = SPIRV_CACHE_MAGIC;
+  header->count = count;
+  header->version = state.spirvVersion;
+  *size = cursor - (char*) data;
+
+  mtx_unlock(&state.spirvLock);
+}
+
 void lovrGraphicsGetBackgroundColor(float background[4]) {
   background[0] = lovrMathLinearToGamma(state.background[0]);
   background[1] = lovrMathLinearToGamma(state.background[1]);
@@ -1100,6 +1297,173 @@ static void recordComputePass(Pass* pass, gpu_stream* stream) {
   gpu_compute_end(stream);
 }
 
+static uint32_t hashPointer(void* pointer, uint32_t bits) {
+  return (uint32_t) (((uint64_t) (uintptr_t) pointer * 0x9e3779b97f4a7c15ull) >> (64 - bits));
+}
+
+// Orders draws by camera, and within each camera puts opaque draws first, sorted by state (front to
+// back within the same state), then blended draws back to front.  The camera is the top byte of the
+// key and the blend flag is the bit below it.  Keys are sorted with an LSD radix sort, skipping
+// uniform bytes.
+static void sortDraws(Pass* pass, uint16_t* draws, uint32_t count) {
+  uint64_t* keys = tempAlloc(&state.allocator, 2 * count * sizeof(uint64_t));
+  uint16_t* indices = tempAlloc(&state.allocator, count * sizeof(uint16_t));
+  uint64_t* keysOut = keys + count;
+
+  for (uint32_t i = 0; i < count; i++) {
+    Draw* draw = &pass->draws[draws[i]];
+    float* view = pass->cameras[draw->camera * pass->canvas.views].viewMatrix;
+    float* position = draw->transform + 12;
+    float depth = -(view[2] * position[0] + view[6] * position[1] + view[10] * position[2] + view[14]);
+    uint32_t bits;
+    depth = MAX(depth, 0.f);
+    memcpy(&bits, &depth, sizeof(bits));
+
+    uint64_t camera = MIN(draw->camera, 0xff);
+    uint64_t pipeline = ((char*) draw->pipeline - (char*) state.pipelines) / gpu_sizeof_pipeline();
+
+    if (draw->pipelineInfo->blend[0].enabled) {
+      keys[i] = (camera << 56) | (1ull << 55) | ((uint64_t) ~bits << 23) | (pipeline << 7) | hashPointer(draw->material, 7);
+    } else {
+      uint64_t material = hashPointer(draw->material, 10);
+      uint64_t bundle = hashPointer(draw->bundle, 8);
+      uint64_t vertices = hashPointer(draw->vertexBuffer, 8);
+      keys[i] = (camera << 56) | (pipeline << 39) | (material << 29) | (bundle << 21) | (vertices << 13) | (bits >> 19);
+    }
+  }
+
+  uint16_t* src = draws;
+  uint16_t* dst = indices;
+
+  for (uint32_t shift = 0; shift < 64; shift += 8) {
+    uint32_t counts[256] = { 0 };
+
+    for (uint32_t i = 0; i < count; i++) {
+      counts[(keys[i] >> shift) & 0xff]++;
+    }
+
+    if (counts[(keys[0] >> shift) & 0xff] == count) {
+      continue;
+    }
+
+    for (uint32_t i = 0, total = 0; i < 256; i++) {
+      uint32_t n = counts[i];
+      counts[i] = total;
+      total += n;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+      uint32_t slot = counts[(keys[i] >> shift) & 0xff]++;
+      keysOut[slot] = keys[i];
+      dst[slot] = src[i];
+    }
+
+    uint64_t* tmpKeys = keys;
+    keys = keysOut;
+    keysOut = tmpKeys;
+
+    uint16_t* tmp = src;
+    src = dst;
+    dst = tmp;
+  }
+
+  if (src != draws) {
+    memcpy(draws, src, count * sizeof(uint16_t));
+  }
+}
+
+// Frustum planes for one view, stored as columns so all the planes can be tested at once
+typedef struct {
+  float x[8], y[8], z[8], w[8];
+} Frustum;
+
+typedef struct {
+  Draw* draws;
+  Frustum* frusta;
+  uint32_t views;
+  uint8_t* visible;
+} CullContext;
+
+// Tests oriented bounding boxes against the view frusta of their camera, a draw is visible if it is
+// inside of any view.  A bounding sphere is tried first, and only straddling draws get the box test.
+static void cullDraws(void* arg, uint32_t start, uint32_t count) {
+  CullContext* ctx = arg;
+
+  for (uint32_t i = start; i < start + count; i++) {
+    Draw* draw = &ctx->draws[i];
+
+    if (~draw->flags & DRAW_HAS_BOUNDS) {
+      ctx->visible[i] = true;
+      continue;
+    }
+
+    float* m = draw->transform;
+    float* extent = draw->bounds + 3;
+    float center[3] = { draw->bounds[0], draw->bounds[1], draw->bounds[2] };
+    mat4_mulPoint(m, center);
+
+    float axes[3][3] = {
+      { m[0] * extent[0], m[1] * extent[0], m[2] * extent[0] },
+      { m[4] * extent[1], m[5] * extent[1], m[6] * extent[1] },
+      { m[8] * extent[2], m[9] * extent[2], m[10] * extent[2] }
+    };
+
+    float radius = sqrtf(vec3_dot(axes[0], axes[0]) + vec3_dot(axes[1], axes[1]) + vec3_dot(axes[2], axes[2]));
+    Frustum* frustum = &ctx->frusta[draw->camera * ctx->views];
+    bool visible = false;
+
+    for (uint32_t v = 0; v < ctx->views && !visible; v++, frustum++) {
+      float distance[8];
+      bool inside = true;
+      bool outside = false;
+
+      for (uint32_t p = 0; p < 8; p++) {
+        distance[p] = frustum->x[p] * center[0] + frustum->y[p] * center[1] + frustum->z[p] * center[2] + frustum->w[p];
+        inside &= distance[p] >= radius;
+        outside |= distance[p] <= -radius;
+      }
+
+      if (inside || outside) {
+        visible = inside;
+        continue;
+      }
+
+      visible = true;
+
+      for (uint32_t p = 0; p < 8; p++) {
+        float r =
+          fabsf(frustum->x[p] * axes[0][0] + frustum->y[p] * axes[0][1] + frustum->z[p] * axes[0][2]) +
+          fabsf(frustum->x[p] * axes[1][0] + frustum->y[p] * axes[1][1] + frustum->z[p] * axes[1][2]) +
+          fabsf(frustum->x[p] * axes[2][0] + frustum->y[p] * axes[2][1] + frustum->z[p] * axes[2][2]);
+        visible &= distance[p] + r > 0.f;
+      }
+    }
+
+    ctx->visible[i] = visible;
+  }
+}
+
+static bool canBatch(Draw* a, Draw* b) {
+  return
+    (~a->flags & DRAW_INDIRECT) && (~b->flags & DRAW_INDIRECT) &&
+    a->instances == 1 && b->instances == 1 &&
+    (a->flags & DRAW_INDEX32) == (b->flags & DRAW_INDEX32) &&
+    a->camera == b->camera &&
+    a->tally == b->tally &&
+    a->shader == b->shader &&
+    a->pipeline == b->pipeline &&
+    a->material == b->material &&
+    a->bundle == b->bundle &&
+    a->uniformBuffer == b->uniformBuffer &&
+    a->uniformOffset == b->uniformOffset &&
+    a->vertexBuffer == b->vertexBuffer &&
+    a->vertexBufferOffset == b->vertexBufferOffset &&
+    a->indexBuffer == b->indexBuffer &&
+    a->start == b->start &&
+    a->count == b->count &&
+    a->baseVertex == b->baseVertex;
+}
+
 static void recordRenderPass(Pass* pass, gpu_stream* stream) {
   Canvas* canvas = &pass->canvas;
 
@@ -1153,78 +1517,49 @@ static void recordRenderPass(Pass* pass, gpu_stream* stream) {
   uint16_t* activeDraws = tempAlloc(&state.allocator, pass->drawCount * sizeof(uint16_t));
 
   if (pass->flags & NEEDS_VIEW_CULL) {
-    typedef struct { float planes[6][4]; } Frustum;
-    Frustum* frusta = tempAlloc(&state.allocator, canvas->views * sizeof(Frustum));
-    uint32_t drawIndex = 0;
-
-    for (uint32_t c = 0; c < pass->cameraCount; c++) {
-      for (uint32_t v = 0; v < canvas->views; v++) {
-        float* m = pass->cameras[c * canvas->views + v].viewProjection;
-        memcpy(frusta[v].planes, (float[6][4]) {
-          { (m[3] + m[0]), (m[7] + m[4]), (m[11] + m[8]), (m[15] + m[12]) }, // Left
-          { (m[3] - m[0]), (m[7] - m[4]), (m[11] - m[8]), (m[15] - m[12]) }, // Right
-          { (m[3] + m[1]), (m[7] + m[5]), (m[11] + m[9]), (m[15] + m[13]) }, // Bottom
-          { (m[3] - m[1]), (m[7] - m[5]), (m[11] - m[9]), (m[15] - m[13]) }, // Top
-          { m[2], m[6], m[10], m[14] }, // Near
-          { (m[3] - m[2]), (m[7] - m[6]), (m[11] - m[10]), (m[15] - m[14]) } // Far
-        }, sizeof(Frustum));
-      }
-
-      while (drawIndex < pass->drawCount) {
-        Draw* draw = &pass->draws[drawIndex];
-
-        if (draw->camera != c) {
-          break;
-        }
-
-        if (~draw->flags & DRAW_HAS_BOUNDS) {
-          activeDraws[activeDrawCount++] = drawIndex++;
-          continue;
-        }
-
-        float* center = draw->bounds + 0;
-        float* extent = draw->bounds + 3;
-
-        float corners[8][3] = {
-          { center[0] - extent[0], center[1] - extent[1], center[2] - extent[2] },
-          { center[0] - extent[0], center[1] - extent[1], center[2] + extent[2] },
-          { center[0] - extent[0], center[1] + extent[1], center[2] - extent[2] },
-          { center[0] - extent[0], center[1] + extent[1], center[2] + extent[2] },
-          { center[0] + extent[0], center[1] - extent[1], center[2] - extent[2] },
-          { center[0] + extent[0], center[1] - extent[1], center[2] + extent[2] },
-          { center[0] + extent[0], center[1] + extent[1], center[2] - extent[2] },
-          { center[0] + extent[0], center[1] + extent[1], center[2] + extent[2] }
-        };
-
-        for (uint32_t i = 0; i < COUNTOF(corners); i++) {
-          mat4_mulPoint(draw->transform, corners[i]);
-        }
-
-        uint32_t visible = canvas->views;
-
-        for (uint32_t v = 0; v < canvas->views; v++) {
-          for (uint32_t p = 0; p < 6; p++) {
-            bool inside = false;
+    uint32_t frustumCount = pass->cameraCount * canvas->views;
+    Frustum* frusta = tempAlloc(&state.allocator, frustumCount * sizeof(Frustum));
+
+    for (uint32_t i = 0; i < frustumCount; i++) {
+      float* m = pass->cameras[i].viewProjection;
+      float planes[6][4] = {
+        { (m[3] + m[0]), (m[7] + m[4]), (m[11] + m[8]), (m[15] + m[12]) }, // Left
+        { (m[3] - m[0]), (m[7] - m[4]), (m[11] - m[8]), (m[15] - m[12]) }, // Right
+        { (m[3] + m[1]), (m[7] + m[5]), (m[11] + m[9]), (m[15] + m[13]) }, // Bottom
+        { (m[3] - m[1]), (m[7] - m[5]), (m[11] - m[9]), (m[15] - m[13]) }, // Top
+        { m[2], m[6], m[10], m[14] }, // Near
+        { (m[3] - m[2]), (m[7] - m[6]), (m[11] - m[10]), (m[15] - m[14]) } // Far
+      };
 
-            for (uint32_t c = 0; c < COUNTOF(corners); c++) {
-              if (vec3_dot(corners[c], frusta[v].planes[p]) + frusta[v].planes[p][3] > 0.f) {
-                inside = true;
-                break;
-              }
-            }
+      // Planes are normalized for the sphere test, padding planes always pass.  Infinite far planes
+      // (the default reverse-Z projection has one) have no normal, so they're padding too.
+      for (uint32_t p = 0; p < 8; p++) {
+        float length = p < 6 ? vec3_length(planes[p]) : 0.f;
+        bool padding = length < 1e-6f;
+        float scale = padding ? 0.f : 1.f / length;
+        frusta[i].x[p] = padding ? 0.f : planes[p][0] * scale;
+        frusta[i].y[p] = padding ? 0.f : planes[p][1] * scale;
+        frusta[i].z[p] = padding ? 0.f : planes[p][2] * scale;
+        frusta[i].w[p] = padding ? FLT_MAX : planes[p][3] * scale;
+      }
+    }
 
-            if (!inside) {
-              visible--;
-              break;
-            }
-          }
-        }
+    CullContext cull = {
+      .draws = pass->draws,
+      .frusta = frusta,
+      .views = canvas->views,
+      .visible = tempAlloc(&state.allocator, pass->drawCount)
+    };
 
-        if (visible) {
-          activeDraws[activeDrawCount++] = drawIndex;
-        }
+    if (pass->drawCount >= 1024) {
+      job_parallel_for(pass->drawCount, 256, cullDraws, &cull);
+    } else {
+      cullDraws(&cull, 0, pass->drawCount);
+    }
 
-        drawIndex++;
+    for (uint32_t i = 0; i < pass->drawCount; i++) {
+      if (cull.visible[i]) {
+        activeDraws[activeDrawCount++] = i;
       }
     }
   } else {
@@ -1234,6 +1569,11 @@ static void recordRenderPass(Pass* pass, gpu_stream* stream) {
   }
 
   pass->stats.drawsCulled = pass->drawCount - activeDrawCount;
+  pass->stats.pipelineBinds = 0;
+  pass->stats.bundleBinds = 0;
+  pass->stats.drawCalls = 0;
+  pass->stats.pipelineWaits = 0;
+  pass->stats.pipelinesCreated = 0;
 
   if (activeDrawCount == 0) {
     gpu_render_begin(stream, &target);
@@ -1241,6 +1581,72 @@ static void recordRenderPass(Pass* pass, gpu_stream* stream) {
     return;
   }
 
+  // Pipelines
+
+  if (!pass->draws[pass->drawCount - 1].pipeline) {
+    uint32_t first = 0;
+
+    while (pass->draws[first].pipeline) {
+      first++; // TODO could binary search or cache
+    }
+
+    for (uint32_t i = first; i < pass->drawCount; i++) {
+      Draw* prev = &pass->draws[i - 1];
+      Draw* draw = &pass->draws[i];
+
+      if (i > 0 && draw->pipelineInfo == prev->pipelineInfo) {
+        draw->pipeline = prev->pipeline;
+        continue;
+      }
+
+      uint64_t hash = hash64(draw->pipelineInfo, sizeof(gpu_pipeline_info));
+      uint64_t index = map_get(&state.pipelineLookup, hash);
+
+      if (index != MAP_NIL && (index & PIPELINE_PENDING)) {
+        finishWarmup();
+        index &= ~PIPELINE_PENDING;
+        pass->stats.pipelineWaits++;
+      }
+
+      if (index == MAP_NIL) {
+        lovrAssert(state.pipelineCount < MAX_PIPELINES, "Too many pipelines!");
+        index = state.pipelineCount++;
+        os_vm_commit(state.pipelines, state.pipelineCount * gpu_sizeof_pipeline());
+        gpu_pipeline_init_graphics(getPipeline(index), draw->pipelineInfo);
+        map_set(&state.pipelineLookup, hash, index);
+        pass->stats.pipelinesCreated++;
+      }
+
+      draw->pipeline = getPipeline(index);
+    }
+  }
+
+  // Bundles
+
+  Draw* prev = NULL;
+  for (uint32_t i = 0; i < activeDrawCount; i++) {
+    Draw* draw = &pass->draws[activeDraws[i]];
+
+    if (i > 0 && draw->bundleInfo == prev->bundleInfo) {
+      draw->bundle = prev->bundle;
+      continue;
+    }
+
+    if (draw->bundleInfo) {
+      draw->bundle = getBundle(draw->shader->layout, draw->bundleInfo->bindings, draw->bundleInfo->count);
+    } else {
+      draw->bundle = NULL;
+    }
+
+    prev = draw;
+  }
+
+  // Sorting
+
+  if (pass->sorting && pass->tally.count == 0) {
+    sortDraws(pass, activeDraws, activeDrawCount);
+  }
+
   // Builtins
 
   gpu_binding builtins[] = {
@@ -1295,91 +1701,38 @@ static void recordRenderPass(Pass* pass, gpu_stream* stream) {
 
   gpu_bundle* builtinBundle = getBundle(LAYOUT_BUILTINS, builtins, COUNTOF(builtins));
 
-  // Pipelines
+  // Tally
 
-  if (!pass->draws[pass->drawCount - 1].pipeline) {
-    uint32_t first = 0;
+  if (pass->tally.active) {
+    lovrPassFinishTally(pass);
+  }
 
-    while (pass->draws[first].pipeline) {
-      first++; // TODO could binary search or cache
-    }
+  if (pass->tally.buffer && pass->tally.count > 0) {
+    if (!pass->tally.gpu) {
+      pass->tally.gpu = lovrMalloc(gpu_sizeof_tally());
+      gpu_tally_init(pass->tally.gpu, &(gpu_tally_info) {
+        .type = GPU_TALLY_PIXEL,
+        .count = MAX_TALLIES * state.limits.renderSize[2]
+      });
 
-    for (uint32_t i = first; i < pass->drawCount; i++) {
-      Draw* prev = &pass->draws[i - 1];
-      Draw* draw = &pass->draws[i];
+      BufferInfo info = { .size = MAX_TALLIES * state.limits.renderSize[2] * sizeof(uint32_t) };
+      pass->tally.tempBuffer = lovrBufferCreate(&info, NULL);
+    }
 
-      if (i > 0 && draw->pipelineInfo == prev->pipelineInfo) {
-        draw->pipeline = prev->pipeline;
-        continue;
-      }
+    gpu_clear_tally(stream, pass->tally.gpu, 0, pass->tally.count * canvas->views);
+  }
 
-      uint64_t hash = hash64(draw->pipelineInfo, sizeof(gpu_pipeline_info));
-      uint64_t index = map_get(&state.pipelineLookup, hash);
+  // Do the thing!
 
-      if (index == MAP_NIL) {
-        lovrAssert(state.pipelineCount < MAX_PIPELINES, "Too many pipelines!");
-        index = state.pipelineCount++;
-        os_vm_commit(state.pipelines, state.pipelineCount * gpu_sizeof_pipeline());
-        gpu_pipeline_init_graphics(getPipeline(index), draw->pipelineInfo);
-        map_set(&state.pipelineLookup, hash, index);
-      }
+  gpu_render_begin(stream, &target);
 
-      draw->pipeline = getPipeline(index);
-    }
-  }
+  float defaultViewport[6] = { 0.f, 0.f, (float) canvas->width, (float) canvas->height, 0.f, 1.f };
+  uint32_t defaultScissor[4] = { 0, 0, canvas->width, canvas->height };
+  float* viewport = pass->viewport[2] == 0.f && pass->viewport[3] == 0.f ? defaultViewport : pass->viewport;
+  uint32_t* scissor = pass->scissor[2] == 0 && pass->scissor[3] == 0 ? defaultScissor : pass->scissor;
 
-  // Bundles
-
-  Draw* prev = NULL;
-  for (uint32_t i = 0; i < activeDrawCount; i++) {
-    Draw* draw = &pass->draws[activeDraws[i]];
-
-    if (i > 0 && draw->bundleInfo == prev->bundleInfo) {
-      draw->bundle = prev->bundle;
-      continue;
-    }
-
-    if (draw->bundleInfo) {
-      draw->bundle = getBundle(draw->shader->layout, draw->bundleInfo->bindings, draw->bundleInfo->count);
-    } else {
-      draw->bundle = NULL;
-    }
-
-    prev = draw;
-  }
-
-  // Tally
-
-  if (pass->tally.active) {
-    lovrPassFinishTally(pass);
-  }
-
-  if (pass->tally.buffer && pass->tally.count > 0) {
-    if (!pass->tally.gpu) {
-      pass->tally.gpu = lovrMalloc(gpu_sizeof_tally());
-      gpu_tally_init(pass->tally.gpu, &(gpu_tally_info) {
-        .type = GPU_TALLY_PIXEL,
-        .count = MAX_TALLIES * state.limits.renderSize[2]
-      });
-
-      BufferInfo info = { .size = MAX_TALLIES * state.limits.renderSize[2] * sizeof(uint32_t) };
-      pass->tally.tempBuffer = lovrBufferCreate(&info, NULL);
-    }
-
-    gpu_clear_tally(stream, pass->tally.gpu, 0, pass->tally.count * canvas->views);
-  }
-
-  // Do the thing!
-
-  gpu_render_begin(stream, &target);
-
-  float defaultViewport[6] = { 0.f, 0.f, (float) canvas->width, (float) canvas->height, 0.f, 1.f };
-  uint32_t defaultScissor[4] = { 0, 0, canvas->width, canvas->height };
-  float* viewport = pass->viewport[2] == 0.f && pass->viewport[3] == 0.f ? defaultViewport : pass->viewport;
-  uint32_t* scissor = pass->scissor[2] == 0 && pass->scissor[3] == 0 ? defaultScissor : pass->scissor;
-
-  gpu_set_viewport(stream, viewport, viewport + 4);
-  gpu_set_scissor(stream, scissor);
+  gpu_set_viewport(stream, viewport, viewport + 4);
+  gpu_set_scissor(stream, scissor);
 
   uint16_t cameraIndex = 0xffff;
   uint32_t tally = ~0u;
@@ -1409,22 +1762,26 @@ static void recordRenderPass(Pass* pass, gpu_stream* stream) {
     if (draw->pipeline != pipeline) {
       gpu_bind_pipeline(stream, draw->pipeline, GPU_PIPELINE_GRAPHICS);
       pipeline = draw->pipeline;
+      pass->stats.pipelineBinds++;
     }
 
     if ((i & 0xff) == 0 || draw->camera != cameraIndex) {
       uint32_t dynamicOffsets[] = { draw->camera * canvas->views * sizeof(Camera), (i >> 8) * 256 * sizeof(DrawData) };
       gpu_bind_bundles(stream, draw->shader->gpu, &builtinBundle, 0, 1, dynamicOffsets, COUNTOF(dynamicOffsets));
       cameraIndex = draw->camera;
+      pass->stats.bundleBinds++;
     }
 
     if (draw->material != material) {
       gpu_bind_bundles(stream, draw->shader->gpu, &draw->material->bundle, 1, 1, NULL, 0);
       material = draw->material;
+      pass->stats.bundleBinds++;
     }
 
     if (draw->bundle && (draw->bundle != bundle)) {
       gpu_bind_bundles(stream, draw->shader->gpu, &draw->bundle, 2, 1, NULL, 0);
       bundle = draw->bundle;
+      pass->stats.bundleBinds++;
     }
 
     if (draw->uniformBuffer && (draw->uniformBuffer != uniformBuffer || draw->uniformOffset != uniformOffset)) {
@@ -1439,6 +1796,7 @@ static void recordRenderPass(Pass* pass, gpu_stream* stream) {
       }
 
       gpu_bind_bundles(stream, draw->shader->gpu, &uniformBundle, 3, 1, &draw->uniformOffset, 1);
+      pass->stats.bundleBinds++;
       uniformBuffer = draw->uniformBuffer;
       uniformOffset = draw->uniformOffset;
     }
@@ -1459,7 +1817,25 @@ static void recordRenderPass(Pass* pass, gpu_stream* stream) {
     }
 
     uint32_t DrawID = i & 0xff;
+    uint32_t instances = draw->instances;
+
+    // Merge runs of identical draws in the same DrawData block into one instanced draw
+    if (pass->batching) {
+      uint32_t n = 1;
+
+      while (i + n < activeDrawCount && ((i + n) & 0xff) != 0 && canBatch(draw, &pass->draws[activeDraws[i + n]])) {
+        n++;
+      }
+
+      if (n > 1) {
+        DrawID |= 0x80000000;
+        instances = n;
+        i += n - 1;
+      }
+    }
+
     gpu_push_constants(stream, draw->shader->gpu, &DrawID, sizeof(DrawID));
+    pass->stats.drawCalls++;
 
     if (draw->flags & DRAW_INDIRECT) {
       if (draw->indexBuffer) {
@@ -1469,9 +1845,9 @@ static void recordRenderPass(Pass* pass, gpu_stream* stream) {
       }
     } else {
       if (draw->indexBuffer) {
-        gpu_draw_indexed(stream, draw->count, draw->instances, draw->start, draw->baseVertex, 0);
+        gpu_draw_indexed(stream, draw->count, instances, draw->start, draw->baseVertex, 0);
       } else {
-        gpu_draw(stream, draw->count, draw->instances, draw->start, 0);
+        gpu_draw(stream, draw->count, instances, draw->start, 0);
       }
     }
   }
@@ -1562,6 +1938,12 @@ static Readback* lovrReadbackCreateTimestamp(TimingInfo* passes, uint32_t count,
 void lovrGraphicsSubmit(Pass** passes, uint32_t count) {
   beginFrame();
 
+  if (state.warmups.length > 0 && atomic_load(&state.warmup.pending) == 0) {
+    finishWarmup();
+  }
+
+  flushAnimations();
+
   bool xrCanvas = false;
   uint32_t streamCount = 0;
   uint32_t maxStreams = count + 3;
@@ -1810,6 +2192,68 @@ void lovrGraphicsWait(void) {
   processReadbacks();
 }
 
+static void warmPipeline(void* arg) {
+  PipelineWarmup* warmup = arg;
+  warmup->failed = !gpu_pipeline_init_graphics(getPipeline(warmup->index), &warmup->info);
+}
+
+static void onWarmupError(void* arg, const char* format, va_list args) {
+  ((PipelineWarmup*) arg)->failed = true;
+}
+
+static void warmPipelineJob(void* arg) {
+  lovrTry(warmPipeline, arg, onWarmupError, arg);
+}
+
+// Creates the pipelines used by the draws in the passes on the worker threads, without submitting
+// them.  Draws that need a pipeline that is still being created will wait for it.
+void lovrGraphicsPrewarm(Pass** passes, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    Pass* pass = passes[i];
+
+    for (uint32_t j = 0; j < pass->drawCount; j++) {
+      Draw* draw = &pass->draws[j];
+
+      if (draw->pipeline || !draw->pipelineInfo->pass || (j > 0 && draw->pipelineInfo == pass->draws[j - 1].pipelineInfo)) {
+        continue;
+      }
+
+      uint64_t hash = hash64(draw->pipelineInfo, sizeof(gpu_pipeline_info));
+
+      if (map_get(&state.pipelineLookup, hash) != MAP_NIL) {
+        continue;
+      }
+
+      lovrAssert(state.pipelineCount < MAX_PIPELINES, "Too many pipelines!");
+      uint32_t index = state.pipelineCount++;
+      os_vm_commit(state.pipelines, state.pipelineCount * gpu_sizeof_pipeline());
+
+      // The shader's flags and label might be freed before the job runs
+      PipelineWarmup* warmup = lovrCalloc(sizeof(PipelineWarmup));
+      warmup->hash = hash;
+      warmup->index = index;
+      warmup->shader = draw->shader;
+      warmup->info = *draw->pipelineInfo;
+      lovrRetain(warmup->shader);
+      warmup->info.flags = lovrMalloc(warmup->info.flagCount * sizeof(gpu_shader_flag));
+      memcpy(warmup->info.flags, draw->pipelineInfo->flags, warmup->info.flagCount * sizeof(gpu_shader_flag));
+
+      if (draw->pipelineInfo->label) {
+        size_t size = strlen(draw->pipelineInfo->label) + 1;
+        warmup->info.label = memcpy(lovrMalloc(size), draw->pipelineInfo->label, size);
+      }
+
+      map_set(&state.pipelineLookup, hash, index | PIPELINE_PENDING);
+      arr_push(&state.warmups, warmup);
+      job_group_start(&state.warmup, warmPipelineJob, warmup);
+    }
+  }
+}
+
+bool lovrGraphicsIsPrewarming(void) {
+  return atomic_load(&state.warmup.pending) > 0;
+}
+
 // Buffer
 
 uint32_t lovrGraphicsAlignFields(DataField* parent, DataLayout layout) {
@@ -2003,6 +2447,7 @@ const BufferInfo* lovrBufferGetInfo(Buffer* buffer) {
 
 void* lovrBufferGetData(Buffer* buffer, uint32_t offset, uint32_t extent) {
   beginFrame();
+  flushAnimations();
   if (extent == ~0u) extent = buffer->info.size - offset;
   lovrCheck(offset + extent <= buffer->info.size, "Buffer read range goes past the end of the Buffer");
 
@@ -2020,6 +2465,7 @@ void* lovrBufferGetData(Buffer* buffer, uint32_t offset, uint32_t extent) {
 
 void* lovrBufferSetData(Buffer* buffer, uint32_t offset, uint32_t extent) {
   beginFrame();
+  flushAnimations();
   if (extent == ~0u) extent = buffer->info.size - offset;
   lovrCheck(offset + extent <= buffer->info.size, "Attempt to write past the end of the Buffer");
   BufferView view = getBuffer(GPU_BUFFER_UPLOAD, extent, 4);
@@ -2031,6 +2477,7 @@ void* lovrBufferSetData(Buffer* buffer, uint32_t offset, uint32_t extent) {
 
 void lovrBufferCopy(Buffer* src, Buffer* dst, uint32_t srcOffset, uint32_t dstOffset, uint32_t extent) {
   beginFrame();
+  flushAnimations();
   lovrCheck(srcOffset + extent <= src->info.size, "Buffer copy range goes past the end of the source Buffer");
   lovrCheck(dstOffset + extent <= dst->info.size, "Buffer copy range goes past the end of the destination Buffer");
   lovrCheck(src != dst || (srcOffset >= dstOffset + extent || dstOffset >= srcOffset + extent), "Copying part of a Buffer to itself requires non-overlapping copy regions");
@@ -2048,6 +2495,7 @@ void lovrBufferClear(Buffer* buffer, uint32_t offset, uint32_t extent, uint32_t
   lovrCheck(extent % 4 == 0, "Buffer clear extent must be a multiple of 4");
   lovrCheck(offset + extent <= buffer->info.size, "Buffer clear range goes past the end of the Buffer");
   beginFrame();
+  flushAnimations();
   gpu_barrier barrier = syncTransfer(&buffer->sync, GPU_PHASE_CLEAR, GPU_CACHE_TRANSFER_WRITE);
   gpu_sync(state.stream, &barrier, 1);
   gpu_clear_buffer(state.stream, buffer->gpu, buffer->base + offset, extent, value);
@@ -2595,18 +3043,175 @@ const SamplerInfo* lovrSamplerGetInfo(Sampler* sampler) {
 
 // Shader
 
+typedef struct {
+  ShaderIncluder* io;
+  arr_t(char) includes;
+  uint32_t includeCount;
+} IncludeContext;
+
+static void loadSpirvCache(void* data, size_t size) {
+  SpirvCacheHeader* header = data;
+
+  if (!data || size < sizeof(*header) || header->magic != SPIRV_CACHE_MAGIC || header->version != state.spirvVersion) {
+    return;
+  }
+
+  char* cursor = (char*) (header + 1);
+  size -= sizeof(*header);
+
+  for (uint32_t i = 0; i < header->count; i++) {
+    SpirvCacheEntry* entry = (SpirvCacheEntry*) cursor;
+    if (size < sizeof(*entry) || entry->size < sizeof(*entry) || entry->size > size || entry->size % 8) break;
+    if (map_get(&state.spirvLookup, entry->key) == MAP_NIL) {
+      map_set(&state.spirvLookup, entry->key, state.spirvCache.length);
+      arr_append(&state.spirvCache, cursor, entry->size);
+    }
+    cursor += entry->size;
+    size -= entry->size;
+  }
+}
+
+// The key covers the compiler, the stage sources, and debug info.  Includes are checked on lookup.
+static uint64_t hashShaderSource(ShaderSource* stages, uint32_t count) {
+  uint64_t hashes[7] = { state.spirvVersion, state.config.debug && state.features.shaderDebug, count };
+  for (uint32_t i = 0; i < count; i++) {
+    hashes[3 + 2 * i + 0] = stages[i].stage;
+    hashes[3 + 2 * i + 1] = hash64(stages[i].code, stages[i].size);
+  }
+  return hash64(hashes, sizeof(hashes));
+}
+
+static bool readSpirv(uint64_t key, ShaderSource* outputs, uint32_t count, ShaderIncluder* io) {
+  mtx_lock(&state.spirvLock);
+  uint64_t offset = map_get(&state.spirvLookup, key);
+
+  if (offset == MAP_NIL) {
+    mtx_unlock(&state.spirvLock);
+    return false;
+  }
+
+  SpirvCacheEntry* entry = (SpirvCacheEntry*) (state.spirvCache.data + offset);
+  char* data = lovrMalloc(entry->size);
+  memcpy(data, entry, entry->size);
+  mtx_unlock(&state.spirvLock);
+
+  entry = (SpirvCacheEntry*) data;
+  char* cursor = data + sizeof(*entry);
+  char* end = data + entry->size;
+  bool valid = entry->stageCount == count;
+
+  for (uint32_t i = 0; i < entry->includeCount && valid; i++) {
+    SpirvCacheInclude* include = (SpirvCacheInclude*) cursor;
+    char* path = (char*) (include + 1);
+    if (!(valid = path <= end && path + ALIGN(include->length, 8) <= end)) break;
+    if (!(valid = include->length > 0 && path[include->length - 1] == '\0')) break;
+    cursor = path + ALIGN(include->length, 8);
+    size_t size;
+    void* contents = io(path, &size);
+    valid = contents && hash64(contents, size) == include->hash;
+    lovrFree(contents);
+  }
+
+  uint32_t stageCount = 0;
+
+  while (valid && stageCount < count) {
+    SpirvCacheStage* stage = (SpirvCacheStage*) cursor;
+    char* code = (char*) (stage + 1);
+    if (!(valid = code <= end && code + ALIGN(stage->size, 8) <= end)) break;
+    cursor = code + ALIGN(stage->size, 8);
+    ShaderSource* output = &outputs[stageCount++];
+    output->stage = stage->stage;
+    output->size = stage->size;
+    output->code = lovrMalloc(stage->size);
+    memcpy((void*) output->code, code, stage->size);
+  }
+
+  if (!valid) {
+    for (uint32_t i = 0; i < stageCount; i++) {
+      lovrFree((void*) outputs[i].code);
+    }
+  }
+
+  lovrFree(data);
+  return valid;
+}
+
+static void writeSpirv(uint64_t key, ShaderSource* outputs, uint32_t count, IncludeContext* context) {
+  arr_t(char) data;
+  arr_init(&data);
+
+  SpirvCacheEntry entry = { .key = key, .includeCount = context->includeCount, .stageCount = count };
+  arr_append(&data, (char*) &entry, sizeof(entry));
+  arr_append(&data, context->includes.data, context->includes.length);
+
+  for (uint32_t i = 0; i < count; i++) {
+    SpirvCacheStage stage = { outputs[i].stage, (uint32_t) outputs[i].size };
+    arr_append(&data, (char*) &stage, sizeof(stage));
+    arr_append(&data, (char*) outputs[i].code, outputs[i].size);
+    arr_reserve(&data, ALIGN(data.length, 8));
+    memset(data.data + data.length, 0, ALIGN(data.length, 8) - data.length);
+    data.length = ALIGN(data.length, 8);
+  }
+
+  ((SpirvCacheEntry*) data.data)->size = (uint32_t) data.length;
+
+  // A stale entry (with an outdated include) gets replaced, and is skipped when saving the cache
+  mtx_lock(&state.spirvLock);
+  map_set(&state.spirvLookup, key, state.spirvCache.length);
+  arr_append(&state.spirvCache, data.data, data.length);
+  state.spirvDirty = true;
+  mtx_unlock(&state.spirvLock);
+
+  arr_free(&data);
+}
+
 #ifdef LOVR_USE_GLSLANG
 static glsl_include_result_t* includer(void* cb, const char* path, const char* includer, size_t depth) {
   if (!strcmp(path, includer)) {
     return NULL;
   }
-  glsl_include_result_t* result = tempAlloc(&state.allocator, sizeof(*result));
-  lovrAssert(result, "Out of memory");
+  IncludeContext* context = cb;
+  glsl_include_result_t* result = lovrMalloc(sizeof(*result));
   result->header_name = path;
-  result->header_data = ((ShaderIncluder*) cb)(path, &result->header_length);
-  if (!result->header_data) return NULL;
+  result->header_data = context->io(path, &result->header_length);
+  if (!result->header_data) {
+    lovrFree(result);
+    return NULL;
+  }
+
+  // Record the contents of each include so cached SPIR-V can be invalidated when they change
+  SpirvCacheInclude include = { hash64(result->header_data, result->header_length), (uint32_t) strlen(path) + 1, 0 };
+  size_t padding = ALIGN(include.length, 8) - include.length;
+  arr_append(&context->includes, (char*) &include, sizeof(include));
+  arr_append(&context->includes, path, include.length);
+  arr_append(&context->includes, "\0\0\0\0\0\0\0", padding);
+  context->includeCount++;
   return result;
 }
+
+static int freeInclude(void* cb, glsl_include_result_t* result) {
+  lovrFree((void*) result->header_data);
+  lovrFree(result);
+  return 0;
+}
+
+static void freeCompiler(glslang_program_t* program, glslang_shader_t** shaders, char** code, uint32_t count, IncludeContext* context) {
+  if (program) glslang_program_delete(program);
+  for (uint32_t i = 0; i < count; i++) {
+    if (shaders[i]) glslang_shader_delete(shaders[i]);
+    lovrFree(code[i]);
+  }
+  arr_free(&context->includes);
+}
+
+// The info log belongs to the shader/program, so the message is copied before freeing everything
+#define COMPILER_THROW(...) \
+  do { \
+    char message[4096]; \
+    snprintf(message, sizeof(message), __VA_ARGS__); \
+    freeCompiler(program, shaders, code, stageCount, &context); \
+    lovrThrow("%s", message); \
+  } while (0)
 #endif
 
 void lovrGraphicsCompileShader(ShaderSource* stages, ShaderSource* outputs, uint32_t stageCount, ShaderIncluder* io) {
@@ -2631,11 +3236,21 @@ void lovrGraphicsCompileShader(ShaderSource* stages, ShaderSource* outputs, uint
 
   glslang_program_t* program = NULL;
   glslang_shader_t* shaders[2] = { 0 };
+  char* code[2] = { 0 };
 
   if (stageCount > COUNTOF(shaders)) {
     lovrUnreachable();
   }
 
+  uint64_t key = state.ref ? hashShaderSource(stages, stageCount) : 0;
+
+  if (key && readSpirv(key, outputs, stageCount, io)) {
+    return;
+  }
+
+  IncludeContext context = { .io = io };
+  arr_init(&context.includes);
+
   for (uint32_t i = 0; i < stageCount; i++) {
     ShaderSource* source = &stages[i];
 
@@ -2670,13 +3285,14 @@ void lovrGraphicsCompileShader(ShaderSource* stages, ShaderSource* outputs, uint
       totalLength += lengths[i];
     }
 
+    // This can run on any thread, so it doesn't use temp memory
     size_t cursor = 0;
-    char* code = tempAlloc(&state.allocator, totalLength + 1);
-    for (size_t i = 0; i < COUNTOF(strings); i++) {
-      memcpy(code + cursor, strings[i], lengths[i]);
-      cursor += lengths[i];
+    code[i] = lovrMalloc(totalLength + 1);
+    for (size_t j = 0; j < COUNTOF(strings); j++) {
+      memcpy(code[i] + cursor, strings[j], lengths[j]);
+      cursor += lengths[j];
     }
-    code[cursor] = '\0';
+    code[i][cursor] = '\0';
 
     const glslang_resource_t* resource = glslang_default_resource();
 
@@ -2687,13 +3303,14 @@ void lovrGraphicsCompileShader(ShaderSource* stages, ShaderSource* outputs, uint
       .client_version = GLSLANG_TARGET_VULKAN_1_1,
       .target_language = GLSLANG_TARGET_SPV,
       .target_language_version = GLSLANG_TARGET_SPV_1_3,
-      .code = code,
+      .code = code[i],
       .default_version = 460,
       .default_profile = GLSLANG_NO_PROFILE,
       .forward_compatible = true,
       .resource = resource,
       .callbacks.include_local = includer,
-      .callbacks_ctx = (void*) io
+      .callbacks.free_include_result = freeInclude,
+      .callbacks_ctx = &context
     };
 
     shaders[i] = glslang_shader_create(&input);
@@ -2706,11 +3323,11 @@ void lovrGraphicsCompileShader(ShaderSource* stages, ShaderSource* outputs, uint
     glslang_shader_set_options(shaders[i], options);
 
     if (!glslang_shader_preprocess(shaders[i], &input)) {
-      lovrThrow("Could not preprocess %s shader:\n%s", stageNames[source->stage], glslang_shader_get_info_log(shaders[i]));
+      COMPILER_THROW("Could not preprocess %s shader:\n%s", stageNames[source->stage], glslang_shader_get_info_log(shaders[i]));
     }
 
     if (!glslang_shader_parse(shaders[i], &input)) {
-      lovrThrow("Could not parse %s shader:\n%s", stageNames[source->stage], glslang_shader_get_info_log(shaders[i]));
+      COMPILER_THROW("Could not parse %s shader:\n%s", stageNames[source->stage], glslang_shader_get_info_log(shaders[i]));
     }
 
     glslang_program_add_shader(program, shaders[i]);
@@ -2718,11 +3335,12 @@ void lovrGraphicsCompileShader(ShaderSource* stages, ShaderSource* outputs, uint
 
   // We might not need to do anything if all the inputs were already SPIR-V
   if (!program) {
+    arr_free(&context.includes);
     return;
   }
 
   if (!glslang_program_link(program, 0)) {
-    lovrThrow("Could not link shader:\n%s", glslang_program_get_info_log(program));
+    COMPILER_THROW("Could not link shader:\n%s", glslang_program_get_info_log(program));
   }
 
   glslang_program_map_io(program);
@@ -2755,11 +3373,13 @@ void lovrGraphicsCompileShader(ShaderSource* stages, ShaderSource* outputs, uint
     outputs[i].stage = source->stage;
     outputs[i].code = data;
     outputs[i].size = size;
+  }
 
-    glslang_shader_delete(shaders[i]);
+  if (key) {
+    writeSpirv(key, outputs, stageCount, &context);
   }
 
-  glslang_program_delete(program);
+  freeCompiler(program, shaders, code, stageCount, &context);
 #else
   lovrThrow("Could not compile shader: No shader compiler available");
 #endif
@@ -2882,11 +3502,24 @@ Shader* lovrGraphicsGetDefaultShader(DefaultShader type) {
   }
 }
 
-Shader* lovrShaderCreate(const ShaderInfo* info) {
+static Shader* lovrShaderAllocate(const ShaderInfo* info) {
+  // Validate stage combinations
+  uint32_t stageMask = 0;
+  for (uint32_t i = 0; i < info->stageCount; i++) {
+    stageMask |= (1 << info->stages[i].stage);
+  }
+
+  if (info->type == SHADER_GRAPHICS) {
+    lovrCheck(stageMask == (FLAG_VERTEX | FLAG_FRAGMENT), "Graphics shaders must have a vertex and a pixel stage");
+  } else if (info->type == SHADER_COMPUTE) {
+    lovrCheck(stageMask == FLAG_COMPUTE, "Compute shaders can only have a compute stage");
+  }
+
   Shader* shader = lovrCalloc(sizeof(Shader) + gpu_sizeof_shader());
   shader->ref = 1;
   shader->gpu = (gpu_shader*) (shader + 1);
   shader->info = *info;
+  shader->stageMask = stageMask;
 
   if (info->label) {
     size_t size = strlen(info->label) + 1;
@@ -2895,17 +3528,12 @@ Shader* lovrShaderCreate(const ShaderInfo* info) {
     shader->info.label = label;
   }
 
-  // Validate stage combinations
-  for (uint32_t i = 0; i < info->stageCount; i++) {
-    shader->stageMask |= (1 << info->stages[i].stage);
-  }
-
-  if (info->type == SHADER_GRAPHICS) {
-    lovrCheck(shader->stageMask == (FLAG_VERTEX | FLAG_FRAGMENT), "Graphics shaders must have a vertex and a pixel stage");
-  } else if (info->type == SHADER_COMPUTE) {
-    lovrCheck(shader->stageMask == FLAG_COMPUTE, "Compute shaders can only have a compute stage");
-  }
+  return shader;
+}
 
+// Creates the shader from the SPIR-V in its info
+static void lovrShaderLoad(Shader* shader) {
+  const ShaderInfo* info = &shader->info;
   size_t stack = tempPush(&state.allocator);
 
   // Copy the source to temp memory (we perform edits on the SPIR-V and the input might be readonly)
@@ -3262,10 +3890,95 @@ Shader* lovrShaderCreate(const ShaderInfo* info) {
   gpu_shader_init(shader->gpu, &gpu);
   lovrShaderInit(shader);
   tempPop(&state.allocator, stack);
+}
+
+Shader* lovrShaderCreate(const ShaderInfo* info) {
+  Shader* shader = lovrShaderAllocate(info);
+  lovrShaderLoad(shader);
+  return shader;
+}
+
+static void compileShader(void* arg) {
+  Shader* shader = arg;
+  ShaderCompile* compile = shader->compile;
+  lovrGraphicsCompileShader(compile->sources, compile->outputs, shader->info.stageCount, compile->io);
+}
+
+static void onCompileError(void* arg, const char* format, va_list args) {
+  Shader* shader = arg;
+  shader->compile->error = lovrMalloc(1024);
+  vsnprintf(shader->compile->error, 1024, format, args);
+}
+
+static void compileShaderJob(void* arg) {
+  lovrTry(compileShader, arg, onCompileError, arg);
+}
+
+static void freeShaderCompile(Shader* shader) {
+  ShaderCompile* compile = shader->compile;
+  for (uint32_t i = 0; i < shader->info.stageCount; i++) {
+    if (compile->outputs[i].code != compile->sources[i].code) lovrFree((void*) compile->outputs[i].code);
+    lovrFree((void*) compile->sources[i].code);
+  }
+  for (uint32_t i = 0; i < shader->info.flagCount; i++) {
+    lovrFree((char*) compile->flags[i].name);
+  }
+  lovrFree(compile->flags);
+  lovrFree(compile->error);
+  lovrFree(compile);
+  shader->compile = NULL;
+}
+
+// Finishes creating a shader once its compile job is done, this has to happen on the main thread
+static void waitShader(Shader* shader) {
+  if (!shader->compile) {
+    return;
+  }
+
+  job_group_wait(&shader->jobs);
+  lovrAssert(!shader->compile->error, "%s", shader->compile->error);
+
+  shader->info.stages = shader->compile->outputs;
+  shader->info.flags = shader->compile->flags;
+  lovrShaderLoad(shader);
+  shader->info.stages = NULL;
+  shader->info.flags = NULL;
+  freeShaderCompile(shader);
+}
+
+Shader* lovrShaderCreateAsync(const ShaderInfo* info, ShaderIncluder* io) {
+  Shader* shader = lovrShaderAllocate(info);
+  ShaderCompile* compile = shader->compile = lovrCalloc(sizeof(ShaderCompile));
+  compile->io = io;
+
+  for (uint32_t i = 0; i < info->stageCount; i++) {
+    void* code = lovrMalloc(info->stages[i].size);
+    memcpy(code, info->stages[i].code, info->stages[i].size);
+    compile->sources[i] = (ShaderSource) { info->stages[i].stage, code, info->stages[i].size };
+  }
+
+  compile->flags = lovrMalloc(info->flagCount * sizeof(ShaderFlag));
+
+  for (uint32_t i = 0; i < info->flagCount; i++) {
+    compile->flags[i] = info->flags[i];
+    if (info->flags[i].name) {
+      size_t size = strlen(info->flags[i].name) + 1;
+      compile->flags[i].name = memcpy(lovrMalloc(size), info->flags[i].name, size);
+    }
+  }
+
+  shader->info.stages = NULL;
+  shader->info.flags = NULL;
+  job_group_start(&shader->jobs, compileShaderJob, shader);
   return shader;
 }
 
+bool lovrShaderIsComplete(Shader* shader) {
+  return !shader->compile || atomic_load(&shader->jobs.pending) == 0;
+}
+
 Shader* lovrShaderClone(Shader* parent, ShaderFlag* flags, uint32_t count) {
+  waitShader(parent);
   Shader* shader = lovrCalloc(sizeof(Shader) + gpu_sizeof_shader());
   shader->ref = 1;
   lovrRetain(parent);
@@ -3299,6 +4012,13 @@ Shader* lovrShaderClone(Shader* parent, ShaderFlag* flags, uint32_t count) {
 
 void lovrShaderDestroy(void* ref) {
   Shader* shader = ref;
+  if (shader->compile) {
+    job_group_wait(&shader->jobs);
+    freeShaderCompile(shader);
+    lovrFree((char*) shader->info.label);
+    lovrFree(shader);
+    return;
+  }
   if (shader->parent) {
     lovrRelease(shader->parent, lovrShaderDestroy);
   } else {
@@ -3323,6 +4043,7 @@ bool lovrShaderHasStage(Shader* shader, ShaderStage stage) {
 }
 
 bool lovrShaderHasAttribute(Shader* shader, const char* name, uint32_t location) {
+  waitShader(shader);
   if (name) {
     uint32_t hash = (uint32_t) hash64(name, strlen(name));
     for (uint32_t i = 0; i < shader->attributeCount; i++) {
@@ -3342,10 +4063,12 @@ bool lovrShaderHasAttribute(Shader* shader, const char* name, uint32_t location)
 }
 
 void lovrShaderGetWorkgroupSize(Shader* shader, uint32_t size[3]) {
+  waitShader(shader);
   memcpy(size, shader->workgroupSize, 3 * sizeof(uint32_t));
 }
 
 const DataField* lovrShaderGetBufferFormat(Shader* shader, const char* name, uint32_t* fieldCount) {
+  waitShader(shader);
   uint32_t hash = (uint32_t) hash64(name, strlen(name));
   ShaderResource* resource = shader->resources;
 
@@ -3518,6 +4241,8 @@ Font* lovrFontCreate(const FontInfo* info) {
   lovrRetain(info->rasterizer);
   arr_init(&font->glyphs);
   map_init(&font->glyphLookup, 36);
+  arr_init(&font->texts);
+  map_init(&font->textLookup, 0);
 
   font->pixelDensity = lovrRasterizerGetLeading(info->rasterizer);
   font->lineSpacing = 1.f;
@@ -3526,14 +4251,18 @@ Font* lovrFontCreate(const FontInfo* info) {
   Image* image = lovrRasterizerGetAtlas(info->rasterizer);
 
   if (image) {
-    font->atlasWidth = lovrImageGetWidth(image, 0);
-    font->atlasHeight = lovrImageGetHeight(image, 0);
-
-    font->atlas = lovrTextureCreate(&(TextureInfo) {
+    font->pageWidth = lovrImageGetWidth(image, 0);
+    font->pageHeight = lovrImageGetHeight(image, 0);
+    font->pageCount = 1;
+
+    // BMFont atlases are already packed, so the page doesn't get a skyline
+    FontPage* page = &font->pages[0];
+    arr_init(&page->skyline);
+    page->texture = lovrTextureCreate(&(TextureInfo) {
       .type = TEXTURE_2D,
       .format = lovrImageGetFormat(image),
-      .width = font->atlasWidth,
-      .height = font->atlasHeight,
+      .width = font->pageWidth,
+      .height = font->pageHeight,
       .layers = 1,
       .mipmaps = 1,
       .usage = TEXTURE_SAMPLE,
@@ -3543,10 +4272,10 @@ Font* lovrFontCreate(const FontInfo* info) {
       .label = "Font Atlas"
     });
 
-    font->material = lovrMaterialCreate(&(MaterialInfo) {
+    page->material = lovrMaterialCreate(&(MaterialInfo) {
       .data.color = { 1.f, 1.f, 1.f, 1.f },
       .data.uvScale = { 1.f, 1.f },
-      .texture = font->atlas
+      .texture = page->texture
     });
 
     uint32_t glyphCount = lovrRasterizerGetGlyphCount(info->rasterizer);
@@ -3555,42 +4284,58 @@ Font* lovrFontCreate(const FontInfo* info) {
       arr_expand(&font->glyphs, 1);
       Glyph* glyph = &font->glyphs.data[font->glyphs.length++];
       uint32_t codepoint = lovrRasterizerGetAtlasGlyph(info->rasterizer, i, &glyph->x, &glyph->y);
+      glyph->codepoint = codepoint;
+      glyph->page = 0;
       map_set(&font->glyphLookup, hash64(&codepoint, 4), font->glyphs.length - 1);
 
       lovrRasterizerGetGlyphBoundingBox(info->rasterizer, codepoint, glyph->box);
 
       float width = glyph->box[2] - glyph->box[0];
       float height = glyph->box[3] - glyph->box[1];
-      glyph->uv[0] = (uint16_t) ((float) glyph->x / font->atlasWidth * 65535.f + .5f);
-      glyph->uv[1] = (uint16_t) ((float) glyph->y / font->atlasHeight * 65535.f + .5f);
-      glyph->uv[2] = (uint16_t) ((float) (glyph->x + width) / font->atlasWidth * 65535.f + .5f);
-      glyph->uv[3] = (uint16_t) ((float) (glyph->y + height) / font->atlasHeight * 65535.f + .5f);
+      glyph->uv[0] = (uint16_t) ((float) glyph->x / font->pageWidth * 65535.f + .5f);
+      glyph->uv[1] = (uint16_t) ((float) glyph->y / font->pageHeight * 65535.f + .5f);
+      glyph->uv[2] = (uint16_t) ((float) (glyph->x + width) / font->pageWidth * 65535.f + .5f);
+      glyph->uv[3] = (uint16_t) ((float) (glyph->y + height) / font->pageHeight * 65535.f + .5f);
       glyph->advance = lovrRasterizerGetAdvance(font->info.rasterizer, codepoint);
     }
   } else {
-    // Initial atlas size must be big enough to hold any of the glyphs
+    // Pages are created as glyphs are added, and must be big enough to hold a few of any glyph
     float box[4];
-    font->atlasWidth = 1;
-    font->atlasHeight = 1;
+    font->pageWidth = FONT_PAGE_SIZE;
+    font->pageHeight = FONT_PAGE_SIZE;
     lovrRasterizerGetBoundingBox(info->rasterizer, box);
     uint32_t maxWidth = (uint32_t) ceilf(box[2] - box[0]) + 2 * font->padding;
     uint32_t maxHeight = (uint32_t) ceilf(box[3] - box[1]) + 2 * font->padding;
-    while (font->atlasWidth < 2 * maxWidth || font->atlasHeight < 2 * maxHeight) {
-      font->atlasWidth <<= 1;
-      font->atlasHeight <<= 1;
+    while (font->pageWidth < 2 * maxWidth || font->pageHeight < 2 * maxHeight) {
+      font->pageWidth <<= 1;
+      font->pageHeight <<= 1;
     }
+    lovrCheck(font->pageWidth <= 65536, "Font atlas is way too big!");
   }
 
   return font;
 }
 
+static void releaseText(CachedText* text) {
+  lovrRelease(text->vertices, lovrBufferDestroy);
+  lovrFree(text->batches);
+}
+
 void lovrFontDestroy(void* ref) {
   Font* font = ref;
   lovrRelease(font->info.rasterizer, lovrRasterizerDestroy);
-  lovrRelease(font->material, lovrMaterialDestroy);
-  lovrRelease(font->atlas, lovrTextureDestroy);
+  for (uint32_t i = 0; i < font->pageCount; i++) {
+    lovrRelease(font->pages[i].texture, lovrTextureDestroy);
+    lovrRelease(font->pages[i].material, lovrMaterialDestroy);
+    arr_free(&font->pages[i].skyline);
+  }
+  for (size_t i = 0; i < font->texts.length; i++) {
+    releaseText(&font->texts.data[i]);
+  }
   arr_free(&font->glyphs);
   map_free(&font->glyphLookup);
+  arr_free(&font->texts);
+  map_free(&font->textLookup);
   lovrFree(font);
 }
 
@@ -3614,145 +4359,256 @@ void lovrFontSetLineSpacing(Font* font, float spacing) {
   font->lineSpacing = spacing;
 }
 
-static Glyph* lovrFontGetGlyph(Font* font, uint32_t codepoint, bool* resized) {
-  uint64_t hash = hash64(&codepoint, 4);
-  uint64_t index = map_get(&font->glyphLookup, hash);
-
-  if (index != MAP_NIL) {
-    if (resized) *resized = false;
-    return &font->glyphs.data[index];
+static void clearTextCache(Font* font) {
+  for (size_t i = 0; i < font->texts.length; i++) {
+    releaseText(&font->texts.data[i]);
   }
+  arr_clear(&font->texts);
+  map_free(&font->textLookup);
+  map_init(&font->textLookup, 0);
+}
 
-  arr_expand(&font->glyphs, 1);
-  map_set(&font->glyphLookup, hash, font->glyphs.length);
-  Glyph* glyph = &font->glyphs.data[font->glyphs.length++];
+// Pages are cleared when they're created or reused, and glyph uploads have to wait for the clear
+static void clearPage(Font* font, FontPage* page) {
+  beginFrame();
 
-  glyph->advance = lovrRasterizerGetAdvance(font->info.rasterizer, codepoint);
+  float clear[4] = { 0.f, 0.f, 0.f, 0.f };
+  gpu_clear_texture(state.stream, page->texture->gpu, clear, 0, ~0u, 0, ~0u);
 
-  if (lovrRasterizerIsGlyphEmpty(font->info.rasterizer, codepoint)) {
-    memset(glyph->box, 0, sizeof(glyph->box));
-    if (resized) *resized = false;
-    return glyph;
-  }
+  gpu_barrier barrier;
+  barrier.prev = GPU_PHASE_COPY | GPU_PHASE_CLEAR;
+  barrier.next = GPU_PHASE_COPY;
+  barrier.flush = GPU_CACHE_TRANSFER_WRITE;
+  barrier.clear = GPU_CACHE_TRANSFER_WRITE;
+  gpu_sync(state.stream, &barrier, 1);
 
-  lovrRasterizerGetGlyphBoundingBox(font->info.rasterizer, codepoint, glyph->box);
+  arr_clear(&page->skyline);
+  arr_push(&page->skyline, ((SkylineNode) { 0, 0, font->pageWidth }));
+}
 
-  float width = glyph->box[2] - glyph->box[0];
-  float height = glyph->box[3] - glyph->box[1];
-  uint32_t pixelWidth = 2 * font->padding + (uint32_t) ceilf(width);
-  uint32_t pixelHeight = 2 * font->padding + (uint32_t) ceilf(height);
+static void initPage(Font* font, FontPage* page, Texture* texture) {
+  page->texture = texture;
+  page->material = lovrMaterialCreate(&(MaterialInfo) {
+    .data.color = { 1.f, 1.f, 1.f, 1.f },
+    .data.uvScale = { 1.f, 1.f },
+    .data.sdfRange = { font->info.spread / font->pageWidth, font->info.spread / font->pageHeight },
+    .texture = texture
+  });
+  arr_init(&page->skyline);
+  page->tick = state.tick;
+}
 
-  // If the glyph exceeds the width, start a new row
-  if (font->atlasX + pixelWidth > font->atlasWidth) {
-    font->atlasX = font->atlasWidth == font->atlasHeight ? 0 : font->atlasWidth >> 1;
-    font->atlasY += font->rowHeight;
-  }
+static Texture* createPageTexture(Font* font, Image* image) {
+  return lovrTextureCreate(&(TextureInfo) {
+    .type = TEXTURE_2D,
+    .format = FORMAT_RGBA8,
+    .width = font->pageWidth,
+    .height = font->pageHeight,
+    .layers = 1,
+    .mipmaps = 1,
+    .usage = TEXTURE_SAMPLE | TEXTURE_TRANSFER,
+    .imageCount = image ? 1 : 0,
+    .images = image ? &image : NULL,
+    .label = "Font Atlas"
+  });
+}
 
-  // If the glyph exceeds the height, expand the atlas
-  if (font->atlasY + pixelHeight > font->atlasHeight) {
-    if (font->atlasWidth == font->atlasHeight) {
-      font->atlasX = font->atlasWidth;
-      font->atlasY = 0;
-      font->atlasWidth <<= 1;
-      font->rowHeight = 0;
-    } else {
-      font->atlasX = 0;
-      font->atlasY = font->atlasHeight;
-      font->atlasHeight <<= 1;
-      font->rowHeight = 0;
+static uint32_t addPage(Font* font) {
+  FontPage* page = &font->pages[font->pageCount];
+  initPage(font, page, createPageTexture(font, NULL));
+  clearPage(font, page);
+  return font->pageCount++;
+}
+
+// Reuses the least recently used page.  Pages used this frame can't be cleared, since the
+// clear would happen before the passes that sample them are submitted.
+static uint32_t evictPage(Font* font) {
+  uint32_t oldest = ~0u;
+  for (uint32_t i = 0; i < font->pageCount; i++) {
+    if (font->pages[i].tick != state.tick && (oldest == ~0u || font->pages[i].tick < font->pages[oldest].tick)) {
+      oldest = i;
     }
   }
 
-  glyph->x = font->atlasX + font->padding;
-  glyph->y = font->atlasY + font->padding;
-  glyph->uv[0] = (uint16_t) ((float) glyph->x / font->atlasWidth * 65535.f + .5f);
-  glyph->uv[1] = (uint16_t) ((float) glyph->y / font->atlasHeight * 65535.f + .5f);
-  glyph->uv[2] = (uint16_t) ((float) (glyph->x + width) / font->atlasWidth * 65535.f + .5f);
-  glyph->uv[3] = (uint16_t) ((float) (glyph->y + height) / font->atlasHeight * 65535.f + .5f);
+  lovrCheck(oldest != ~0u, "Font atlas is full, too many different glyphs were used in one frame");
 
-  font->atlasX += pixelWidth;
-  font->rowHeight = MAX(font->rowHeight, pixelHeight);
+  // Remove the page's glyphs, the lookup is rebuilt since map_t can't remove
+  size_t kept = 0;
+  for (size_t i = 0; i < font->glyphs.length; i++) {
+    Glyph* glyph = &font->glyphs.data[i];
+    bool empty = glyph->box[2] - glyph->box[0] <= 0.f;
+    if (empty || glyph->page != oldest) {
+      font->glyphs.data[kept++] = *glyph;
+    }
+  }
 
-  beginFrame();
+  font->glyphs.length = kept;
+  map_free(&font->glyphLookup);
+  map_init(&font->glyphLookup, (uint32_t) kept);
+  for (size_t i = 0; i < kept; i++) {
+    map_set(&font->glyphLookup, hash64(&font->glyphs.data[i].codepoint, 4), i);
+  }
 
-  // Atlas resize
-  if (!font->atlas || font->atlasWidth > font->atlas->info.width || font->atlasHeight > font->atlas->info.height) {
-    lovrCheck(font->atlasWidth <= 65536, "Font atlas is way too big!");
+  clearTextCache(font);
+  clearPage(font, &font->pages[oldest]);
+  font->pages[oldest].tick = state.tick;
+  return oldest;
+}
 
-    Texture* atlas = lovrTextureCreate(&(TextureInfo) {
-      .type = TEXTURE_2D,
-      .format = FORMAT_RGBA8,
-      .width = font->atlasWidth,
-      .height = font->atlasHeight,
-      .layers = 1,
-      .mipmaps = 1,
-      .usage = TEXTURE_SAMPLE | TEXTURE_TRANSFER,
-      .label = "Font Atlas"
-    });
+// Finds the lowest position on the skyline where a rectangle fits (ties go to the narrowest node)
+static bool findSkyline(Font* font, FontPage* page, uint32_t width, uint32_t height, uint32_t* index, uint32_t* x, uint32_t* y) {
+  SkylineNode* nodes = page->skyline.data;
+  uint32_t bestY = ~0u;
+  uint32_t bestWidth = ~0u;
 
-    float clear[4] = { 0.f, 0.f, 0.f, 0.f };
-    gpu_clear_texture(state.stream, atlas->gpu, clear, 0, ~0u, 0, ~0u);
-
-    // This barrier serves 2 purposes:
-    // - Ensure new atlas clear is finished/flushed before copying to it
-    // - Ensure any unsynchronized pending uploads to old atlas finish before copying to new atlas
-    gpu_barrier barrier;
-    barrier.prev = GPU_PHASE_COPY | GPU_PHASE_CLEAR;
-    barrier.next = GPU_PHASE_COPY;
-    barrier.flush = GPU_CACHE_TRANSFER_WRITE;
-    barrier.clear = GPU_CACHE_TRANSFER_READ | GPU_CACHE_TRANSFER_WRITE;
-    gpu_sync(state.stream, &barrier, 1);
+  for (uint32_t i = 0; i < page->skyline.length; i++) {
+    if (nodes[i].x + width > font->pageWidth) {
+      break;
+    }
 
-    if (font->atlas) {
-      uint32_t srcOffset[4] = { 0, 0, 0, 0 };
-      uint32_t dstOffset[4] = { 0, 0, 0, 0 };
-      uint32_t extent[3] = { font->atlas->info.width, font->atlas->info.height, 1 };
-      gpu_copy_textures(state.stream, font->atlas->gpu, atlas->gpu, srcOffset, dstOffset, extent);
-      lovrRelease(font->atlas, lovrTextureDestroy);
+    uint32_t top = 0;
+    uint32_t remaining = width;
+    for (uint32_t j = i; remaining > 0; j++) {
+      top = MAX(top, nodes[j].y);
+      remaining -= MIN(remaining, nodes[j].width);
     }
 
-    font->atlas = atlas;
+    if (top + height <= font->pageHeight && (top < bestY || (top == bestY && nodes[i].width < bestWidth))) {
+      bestY = top;
+      bestWidth = nodes[i].width;
+      *index = i;
+      *x = nodes[i].x;
+    }
+  }
 
-    // Material
-    lovrRelease(font->material, lovrMaterialDestroy);
-    font->material = lovrMaterialCreate(&(MaterialInfo) {
-      .data.color = { 1.f, 1.f, 1.f, 1.f },
-      .data.uvScale = { 1.f, 1.f },
-      .data.sdfRange = { font->info.spread / font->atlasWidth, font->info.spread / font->atlasHeight },
-      .texture = font->atlas
-    });
+  *y = bestY;
+  return bestY != ~0u;
+}
 
-    // Recompute all glyph uvs after atlas resize
-    for (size_t i = 0; i < font->glyphs.length; i++) {
-      Glyph* g = &font->glyphs.data[i];
-      if (g->box[2] - g->box[0] > 0.f) {
-        g->uv[0] = (uint16_t) ((float) g->x / font->atlasWidth * 65535.f + .5f);
-        g->uv[1] = (uint16_t) ((float) g->y / font->atlasHeight * 65535.f + .5f);
-        g->uv[2] = (uint16_t) ((float) (g->x + g->box[2] - g->box[0]) / font->atlasWidth * 65535.f + .5f);
-        g->uv[3] = (uint16_t) ((float) (g->y + g->box[3] - g->box[1]) / font->atlasHeight * 65535.f + .5f);
-      }
+static void insertSkyline(FontPage* page, uint32_t index, uint32_t x, uint32_t y, uint32_t width) {
+  arr_expand(&page->skyline, 1);
+  SkylineNode* nodes = page->skyline.data;
+  memmove(nodes + index + 1, nodes + index, (page->skyline.length - index) * sizeof(SkylineNode));
+  nodes[index] = (SkylineNode) { x, y, width };
+  page->skyline.length++;
+
+  // Shrink or remove the nodes covered by the new one
+  uint32_t right = x + width;
+  for (size_t i = index + 1; i < page->skyline.length && nodes[i].x < right;) {
+    uint32_t overlap = right - nodes[i].x;
+    if (overlap >= nodes[i].width) {
+      arr_splice(&page->skyline, i, 1);
+    } else {
+      nodes[i].x += overlap;
+      nodes[i].width -= overlap;
+      break;
     }
+  }
 
-    if (resized) *resized = true;
+  // Merge neighbors with the same height
+  for (size_t i = 0; i + 1 < page->skyline.length;) {
+    if (nodes[i].y == nodes[i + 1].y) {
+      nodes[i].width += nodes[i + 1].width;
+      arr_splice(&page->skyline, i + 1, 1);
+    } else {
+      i++;
+    }
   }
+}
 
-  size_t stack = tempPush(&state.allocator);
-  float* pixels = tempAlloc(&state.allocator, pixelWidth * pixelHeight * 4 * sizeof(float));
-  lovrRasterizerGetPixels(font->info.rasterizer, codepoint, pixels, pixelWidth, pixelHeight, font->info.spread);
-  BufferView view = getBuffer(GPU_BUFFER_UPLOAD, pixelWidth * pixelHeight * 4 * sizeof(uint8_t), 64);
+// Reserves space in one of the atlas pages, adding or evicting a page if none of them have room
+static uint32_t allocateGlyph(Font* font, uint32_t width, uint32_t height, uint32_t* x, uint32_t* y) {
+  uint32_t index;
+
+  for (uint32_t i = 0; i < font->pageCount; i++) {
+    if (findSkyline(font, &font->pages[i], width, height, &index, x, y)) {
+      insertSkyline(&font->pages[i], index, *x, *y + height, width);
+      font->pages[i].tick = state.tick;
+      return i;
+    }
+  }
+
+  uint32_t page = font->pageCount < MAX_FONT_PAGES ? addPage(font) : evictPage(font);
+  findSkyline(font, &font->pages[page], width, height, &index, x, y);
+  insertSkyline(&font->pages[page], index, *x, *y + height, width);
+  return page;
+}
+
+static void getGlyphSize(Font* font, Glyph* glyph, uint32_t* width, uint32_t* height) {
+  *width = 2 * font->padding + (uint32_t) ceilf(glyph->box[2] - glyph->box[0]);
+  *height = 2 * font->padding + (uint32_t) ceilf(glyph->box[3] - glyph->box[1]);
+}
+
+// Adds a glyph and reserves space for it in the atlas (without rasterizing it), returning its index
+static uint32_t lovrFontAddGlyph(Font* font, uint32_t codepoint) {
+  Glyph glyph = { .codepoint = codepoint };
+  glyph.advance = lovrRasterizerGetAdvance(font->info.rasterizer, codepoint);
+
+  if (!lovrRasterizerIsGlyphEmpty(font->info.rasterizer, codepoint)) {
+    lovrRasterizerGetGlyphBoundingBox(font->info.rasterizer, codepoint, glyph.box);
+
+    // This can evict glyphs, so the new glyph is added afterwards
+    uint32_t x, y, width, height;
+    getGlyphSize(font, &glyph, &width, &height);
+    glyph.page = allocateGlyph(font, width, height, &x, &y);
+    glyph.x = x + font->padding;
+    glyph.y = y + font->padding;
+    glyph.uv[0] = (uint16_t) ((float) glyph.x / font->pageWidth * 65535.f + .5f);
+    glyph.uv[1] = (uint16_t) ((float) glyph.y / font->pageHeight * 65535.f + .5f);
+    glyph.uv[2] = (uint16_t) ((float) (glyph.x + glyph.box[2] - glyph.box[0]) / font->pageWidth * 65535.f + .5f);
+    glyph.uv[3] = (uint16_t) ((float) (glyph.y + glyph.box[3] - glyph.box[1]) / font->pageHeight * 65535.f + .5f);
+  }
+
+  arr_push(&font->glyphs, glyph);
+  map_set(&font->glyphLookup, hash64(&codepoint, 4), font->glyphs.length - 1);
+  return font->glyphs.length - 1;
+}
+
+// Only touches the rasterizer and the destination memory, so glyphs can be rasterized on workers
+static void rasterizeGlyph(Font* font, uint32_t codepoint, float* pixels, uint8_t* dst, uint32_t width, uint32_t height) {
+  lovrRasterizerGetPixels(font->info.rasterizer, codepoint, pixels, width, height, font->info.spread);
   float* src = pixels;
-  uint8_t* dst = view.pointer;
-  for (uint32_t y = 0; y < pixelHeight; y++) {
-    for (uint32_t x = 0; x < pixelWidth; x++) {
+  for (uint32_t y = 0; y < height; y++) {
+    for (uint32_t x = 0; x < width; x++) {
       for (uint32_t c = 0; c < 4; c++) {
         float f = *src++; // CLAMP would evaluate this multiple times
         *dst++ = (uint8_t) (CLAMP(f, 0.f, 1.f) * 255.f + .5f);
       }
     }
   }
+}
+
+static void uploadGlyph(Font* font, Glyph* glyph, BufferView* view, size_t offset) {
+  uint32_t width, height;
+  getGlyphSize(font, glyph, &width, &height);
   uint32_t dstOffset[4] = { glyph->x - font->padding, glyph->y - font->padding, 0, 0 };
-  uint32_t extent[3] = { pixelWidth, pixelHeight, 1 };
-  gpu_copy_buffer_texture(state.stream, view.buffer, font->atlas->gpu, view.offset, dstOffset, extent);
+  uint32_t extent[3] = { width, height, 1 };
+  gpu_copy_buffer_texture(state.stream, view->buffer, font->pages[glyph->page].texture->gpu, view->offset + offset, dstOffset, extent);
+}
+
+static Glyph* lovrFontGetGlyph(Font* font, uint32_t codepoint) {
+  uint64_t index = map_get(&font->glyphLookup, hash64(&codepoint, 4));
+
+  if (index != MAP_NIL) {
+    return &font->glyphs.data[index];
+  }
+
+  Glyph* glyph = &font->glyphs.data[lovrFontAddGlyph(font, codepoint)];
+
+  if (glyph->box[2] - glyph->box[0] <= 0.f) {
+    return glyph;
+  }
+
+  beginFrame();
+
+  uint32_t width, height;
+  getGlyphSize(font, glyph, &width, &height);
+
+  size_t stack = tempPush(&state.allocator);
+  float* pixels = tempAlloc(&state.allocator, width * height * 4 * sizeof(float));
+  BufferView view = getBuffer(GPU_BUFFER_UPLOAD, width * height * 4 * sizeof(uint8_t), 64);
+  rasterizeGlyph(font, codepoint, pixels, view.pointer, width, height);
+  uploadGlyph(font, glyph, &view, 0);
   tempPop(&state.allocator, stack);
 
   state.barrier.prev |= GPU_PHASE_COPY;
@@ -3762,10 +4618,271 @@ static Glyph* lovrFontGetGlyph(Font* font, uint32_t codepoint, bool* resized) {
   return glyph;
 }
 
+typedef struct {
+  Font* font;
+  uint32_t* codepoints;
+  size_t* offsets;
+  uint8_t* data;
+} PreloadContext;
+
+static void rasterizeGlyphs(void* arg, uint32_t start, uint32_t count) {
+  PreloadContext* context = arg;
+  Font* font = context->font;
+  float* pixels = NULL;
+  size_t capacity = 0;
+
+  for (uint32_t i = start; i < start + count; i++) {
+    uint32_t codepoint = context->codepoints[i];
+    Glyph* glyph = &font->glyphs.data[map_get(&font->glyphLookup, hash64(&codepoint, 4))];
+    uint32_t width, height;
+    getGlyphSize(font, glyph, &width, &height);
+
+    size_t size = width * height * 4 * sizeof(float);
+    if (size > capacity) {
+      lovrFree(pixels);
+      pixels = lovrMalloc(size);
+      capacity = size;
+    }
+
+    rasterizeGlyph(font, codepoint, pixels, context->data + context->offsets[i], width, height);
+  }
+
+  lovrFree(pixels);
+}
+
+// Rasterizes any missing glyphs on the worker threads and uploads them all at once
+void lovrFontPreload(Font* font, uint32_t* codepoints, uint32_t count) {
+  if (lovrRasterizerGetType(font->info.rasterizer) != RASTERIZER_TTF) {
+    return;
+  }
+
+  size_t stack = tempPush(&state.allocator);
+  uint32_t* pending = tempAlloc(&state.allocator, count * sizeof(uint32_t));
+  uint32_t pendingCount = 0;
+
+  // Adding glyphs can evict other glyphs and move them around, so only codepoints are remembered
+  for (uint32_t i = 0; i < count; i++) {
+    if (map_get(&font->glyphLookup, hash64(&codepoints[i], 4)) == MAP_NIL) {
+      Glyph* glyph = &font->glyphs.data[lovrFontAddGlyph(font, codepoints[i])];
+      if (glyph->box[2] - glyph->box[0] > 0.f) {
+        pending[pendingCount++] = codepoints[i];
+      }
+    }
+  }
+
+  if (pendingCount == 0) {
+    tempPop(&state.allocator, stack);
+    return;
+  }
+
+  size_t* offsets = tempAlloc(&state.allocator, pendingCount * sizeof(size_t));
+  size_t size = 0;
+
+  for (uint32_t i = 0; i < pendingCount; i++) {
+    Glyph* glyph = &font->glyphs.data[map_get(&font->glyphLookup, hash64(&pending[i], 4))];
+    uint32_t width, height;
+    getGlyphSize(font, glyph, &width, &height);
+    offsets[i] = size;
+    size += width * height * 4;
+  }
+
+  beginFrame();
+
+  BufferView view = getBuffer(GPU_BUFFER_UPLOAD, size, 64);
+  PreloadContext context = { font, pending, offsets, view.pointer };
+  job_parallel_for(pendingCount, 0, rasterizeGlyphs, &context);
+
+  for (uint32_t i = 0; i < pendingCount; i++) {
+    Glyph* glyph = &font->glyphs.data[map_get(&font->glyphLookup, hash64(&pending[i], 4))];
+    uploadGlyph(font, glyph, &view, offsets[i]);
+  }
+
+  tempPop(&state.allocator, stack);
+
+  state.barrier.prev |= GPU_PHASE_COPY;
+  state.barrier.next |= GPU_PHASE_SHADER_FRAGMENT;
+  state.barrier.flush |= GPU_CACHE_TRANSFER_WRITE;
+  state.barrier.clear |= GPU_CACHE_TEXTURE;
+}
+
+// Identifies the font file and rasterizer settings that affect the glyphs in the atlas
+static uint64_t getFontFingerprint(Font* font) {
+  Rasterizer* rasterizer = font->info.rasterizer;
+  float key[11] = {
+    lovrRasterizerGetFontSize(rasterizer),
+    lovrRasterizerGetAscent(rasterizer),
+    lovrRasterizerGetDescent(rasterizer),
+    lovrRasterizerGetLeading(rasterizer),
+    (float) lovrRasterizerGetGlyphCount(rasterizer),
+    (float) font->info.spread,
+    (float) font->padding
+  };
+  lovrRasterizerGetBoundingBox(rasterizer, key + 7);
+  uint64_t hash[2] = { hash64(key, sizeof(key)), lovrRasterizerGetHash(rasterizer) };
+  return hash64(hash, sizeof(hash));
+}
+
+Blob* lovrFontGetAtlasCache(Font* font) {
+  lovrCheck(lovrRasterizerGetType(font->info.rasterizer) == RASTERIZER_TTF, "Only TTF fonts can be cached");
+
+  size_t glyphSize = font->glyphs.length * sizeof(Glyph);
+  size_t pageSize = (size_t) font->pageWidth * font->pageHeight * 4;
+  size_t size = sizeof(FontCacheHeader) + glyphSize + font->pageCount * (sizeof(uint32_t) + pageSize);
+  for (uint32_t i = 0; i < font->pageCount; i++) {
+    size += font->pages[i].skyline.length * sizeof(SkylineNode);
+  }
+
+  char* data = lovrMalloc(size);
+  FontCacheHeader* header = (FontCacheHeader*) data;
+  header->magic = FONT_CACHE_MAGIC;
+  header->version = FONT_CACHE_VERSION;
+  header->fingerprint = getFontFingerprint(font);
+  header->pageWidth = font->pageWidth;
+  header->pageHeight = font->pageHeight;
+  header->pageCount = font->pageCount;
+  header->glyphCount = (uint32_t) font->glyphs.length;
+
+  char* cursor = data + sizeof(FontCacheHeader);
+  memcpy(cursor, font->glyphs.data, glyphSize);
+  cursor += glyphSize;
+
+  for (uint32_t i = 0; i < font->pageCount; i++) {
+    FontPage* page = &font->pages[i];
+    uint32_t nodeCount = (uint32_t) page->skyline.length;
+    memcpy(cursor, &nodeCount, sizeof(uint32_t));
+    memcpy(cursor + sizeof(uint32_t), page->skyline.data, nodeCount * sizeof(SkylineNode));
+    cursor += sizeof(uint32_t) + nodeCount * sizeof(SkylineNode);
+  }
+
+  for (uint32_t i = 0; i < font->pageCount; i++) {
+    uint32_t offset[4] = { 0, 0, 0, 0 };
+    uint32_t extent[3] = { font->pageWidth, font->pageHeight, 1 };
+    Image* image = lovrTextureGetPixels(font->pages[i].texture, offset, extent);
+    memcpy(cursor, lovrImageGetLayerData(image, 0, 0), pageSize);
+    lovrRelease(image, lovrImageDestroy);
+    cursor += pageSize;
+  }
+
+  return lovrBlobCreate(data, size, "Font Atlas Cache");
+}
+
+// Replaces the glyphs and atlas with ones from a cache, returns false if the cache doesn't match
+bool lovrFontSetAtlasCache(Font* font, Blob* blob) {
+  FontCacheHeader* header = blob->data;
+
+  if (lovrRasterizerGetType(font->info.rasterizer) != RASTERIZER_TTF) {
+    return false;
+  }
+
+  if (blob->size < sizeof(*header) || header->magic != FONT_CACHE_MAGIC || header->version != FONT_CACHE_VERSION || header->fingerprint != getFontFingerprint(font)) {
+    return false;
+  }
+
+  if (header->pageWidth != font->pageWidth || header->pageHeight != font->pageHeight || header->pageCount > MAX_FONT_PAGES) {
+    return false;
+  }
+
+  // Validate the size before changing anything
+  size_t glyphSize = header->glyphCount * sizeof(Glyph);
+  size_t pageSize = (size_t) header->pageWidth * header->pageHeight * 4;
+  char* cursor = (char*) (header + 1);
+  char* end = (char*) blob->data + blob->size;
+
+  if ((size_t) (end - cursor) < glyphSize) {
+    return false;
+  }
+
+  // Every glyph has to land on a page, and its rectangle (with padding) has to fit inside it
+  for (uint32_t i = 0; i < header->glyphCount; i++) {
+    Glyph glyph;
+    memcpy(&glyph, cursor + i * sizeof(Glyph), sizeof(Glyph));
+
+    if (glyph.page >= header->pageCount) {
+      return false;
+    }
+
+    float width = glyph.box[2] - glyph.box[0];
+    float height = glyph.box[3] - glyph.box[1];
+
+    if (!(width <= FONT_PAGE_SIZE && height <= FONT_PAGE_SIZE)) {
+      return false;
+    }
+
+    if (width > 0.f) {
+      uint32_t w, h;
+      getGlyphSize(font, &glyph, &w, &h);
+      if (glyph.x < font->padding || glyph.y < font->padding) return false;
+      if (glyph.x - font->padding + w > header->pageWidth) return false;
+      if (glyph.y - font->padding + h > header->pageHeight) return false;
+    }
+  }
+
+  cursor += glyphSize;
+
+  for (uint32_t i = 0; i < header->pageCount; i++) {
+    uint32_t nodeCount;
+    if (end - cursor < (ptrdiff_t) sizeof(uint32_t)) return false;
+    memcpy(&nodeCount, cursor, sizeof(uint32_t));
+    cursor += sizeof(uint32_t);
+    if ((size_t) (end - cursor) / sizeof(SkylineNode) < nodeCount) return false;
+
+    for (uint32_t j = 0; j < nodeCount; j++) {
+      SkylineNode node;
+      memcpy(&node, cursor + j * sizeof(SkylineNode), sizeof(SkylineNode));
+      if (node.x > header->pageWidth || node.width > header->pageWidth - node.x || node.y > header->pageHeight) {
+        return false;
+      }
+    }
+
+    cursor += nodeCount * sizeof(SkylineNode);
+  }
+
+  if ((size_t) (end - cursor) != header->pageCount * pageSize) {
+    return false;
+  }
+
+  clearTextCache(font);
+
+  arr_clear(&font->glyphs);
+  arr_append(&font->glyphs, (Glyph*) (header + 1), header->glyphCount);
+  map_free(&font->glyphLookup);
+  map_init(&font->glyphLookup, header->glyphCount);
+  for (uint32_t i = 0; i < header->glyphCount; i++) {
+    map_set(&font->glyphLookup, hash64(&font->glyphs.data[i].codepoint, 4), i);
+  }
+
+  for (uint32_t i = 0; i < font->pageCount; i++) {
+    lovrRelease(font->pages[i].texture, lovrTextureDestroy);
+    lovrRelease(font->pages[i].material, lovrMaterialDestroy);
+    arr_free(&font->pages[i].skyline);
+  }
+
+  font->pageCount = header->pageCount;
+  char* nodes = (char*) (header + 1) + glyphSize;
+  char* pixels = cursor;
+
+  for (uint32_t i = 0; i < font->pageCount; i++) {
+    Image* image = lovrImageCreateRaw(font->pageWidth, font->pageHeight, FORMAT_RGBA8, false);
+    memcpy(lovrImageGetLayerData(image, 0, 0), pixels, pageSize);
+    pixels += pageSize;
+
+    FontPage* page = &font->pages[i];
+    initPage(font, page, createPageTexture(font, image));
+    lovrRelease(image, lovrImageDestroy);
+
+    uint32_t nodeCount;
+    memcpy(&nodeCount, nodes, sizeof(uint32_t));
+    arr_append(&page->skyline, (SkylineNode*) (nodes + sizeof(uint32_t)), nodeCount);
+    nodes += sizeof(uint32_t) + nodeCount * sizeof(SkylineNode);
+  }
+
+  return true;
+}
+
 float lovrFontGetWidth(Font* font, ColoredString* strings, uint32_t count) {
   float x = 0.f;
   float maxWidth = 0.f;
-  float space = lovrFontGetGlyph(font, ' ', NULL)->advance;
+  float space = lovrFontGetGlyph(font, ' ')->advance;
 
   for (uint32_t i = 0; i < count; i++) {
     size_t bytes;
@@ -3790,7 +4907,7 @@ float lovrFontGetWidth(Font* font, ColoredString* strings, uint32_t count) {
         continue;
       }
 
-      Glyph* glyph = lovrFontGetGlyph(font, codepoint, NULL);
+      Glyph* glyph = lovrFontGetGlyph(font, codepoint);
 
       if (previous) x += lovrRasterizerGetKerning(font->info.rasterizer, previous, codepoint);
       previous = codepoint;
@@ -3831,7 +4948,7 @@ void lovrFontGetLines(Font* font, ColoredString* strings, uint32_t count, float
   const char* lineStart = string;
   const char* wordStart = string;
   const char* end = string + totalLength;
-  float space = lovrFontGetGlyph(font, ' ', NULL)->advance;
+  float space = lovrFontGetGlyph(font, ' ')->advance;
   while ((bytes = utf8_decode(string, end, &codepoint)) > 0) {
     if (codepoint == ' ' || codepoint == '\t') {
       x += codepoint == '\t' ? space * 4.f : space;
@@ -3856,7 +4973,7 @@ void lovrFontGetLines(Font* font, ColoredString* strings, uint32_t count, float
       continue;
     }
 
-    Glyph* glyph = lovrFontGetGlyph(font, codepoint, NULL);
+    Glyph* glyph = lovrFontGetGlyph(font, codepoint);
 
     // Keming
     if (previous) x += lovrRasterizerGetKerning(font->info.rasterizer, previous, codepoint);
@@ -3893,7 +5010,17 @@ static void aline(GlyphVertex* vertices, uint32_t head, uint32_t tail, float wid
   }
 }
 
-void lovrFontGetVertices(Font* font, ColoredString* strings, uint32_t count, float wrap, HorizontalAlign halign, VerticalAlign valign, GlyphVertex* vertices, uint32_t* glyphCount, uint32_t* lineCount, Material** material, bool flip) {
+// Glyphs are sorted by atlas page, so each batch of glyphs can be drawn with a single material
+void lovrFontGetVertices(Font* font, ColoredString* strings, uint32_t count, float wrap, HorizontalAlign halign, VerticalAlign valign, GlyphVertex* vertices, uint32_t* glyphCount, uint32_t* lineCount, GlyphBatch* batches, uint32_t* batchCount, bool flip) {
+  size_t totalLength = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    totalLength += strings[i].length;
+  }
+
+  beginFrame();
+  size_t stack = tempPush(&state.allocator);
+  uint16_t* pages = tempAlloc(&state.allocator, totalLength * sizeof(uint16_t));
+
   uint32_t vertexCount = 0;
   uint32_t lineStart = 0;
   uint32_t wordStart = 0;
@@ -3905,7 +5032,7 @@ void lovrFontGetVertices(Font* font, ColoredString* strings, uint32_t count, flo
   float wordStartX = 0.f;
   float prevWordEndX = 0.f;
   float leading = lovrRasterizerGetLeading(font->info.rasterizer) * font->lineSpacing;
-  float space = lovrFontGetGlyph(font, ' ', NULL)->advance;
+  float space = lovrFontGetGlyph(font, ' ')->advance;
 
   for (uint32_t i = 0; i < count; i++) {
     size_t bytes;
@@ -3947,13 +5074,8 @@ void lovrFontGetVertices(Font* font, ColoredString* strings, uint32_t count, flo
         continue;
       }
 
-      bool resized;
-      Glyph* glyph = lovrFontGetGlyph(font, codepoint, &resized);
-
-      if (resized) {
-        lovrFontGetVertices(font, strings, count, wrap, halign, valign, vertices, glyphCount, lineCount, material, flip);
-        return;
-      }
+      Glyph* glyph = lovrFontGetGlyph(font, codepoint);
+      font->pages[glyph->page].tick = state.tick;
 
       // Keming
       if (previous) x += lovrRasterizerGetKerning(font->info.rasterizer, previous, codepoint);
@@ -3992,7 +5114,7 @@ void lovrFontGetVertices(Font* font, ColoredString* strings, uint32_t count, flo
         vertices[vertexCount++] = (GlyphVertex) { { x + bb[0], y + bb[1] }, { uv[0], uv[3] }, { r, g, b, a } };
         vertices[vertexCount++] = (GlyphVertex) { { x + bb[2], y + bb[1] }, { uv[2], uv[3] }, { r, g, b, a } };
       }
-      (*glyphCount)++;
+      pages[(*glyphCount)++] = glyph->page;
 
       // Advance
       x += glyph->advance;
@@ -4003,7 +5125,143 @@ void lovrFontGetVertices(Font* font, ColoredString* strings, uint32_t count, flo
   // Align last line
   aline(vertices, lineStart, vertexCount, x, halign);
 
-  *material = font->material;
+  // Counting sort of the quads by page, most text only uses one page and doesn't need to move
+  uint32_t counts[MAX_FONT_PAGES] = { 0 };
+  for (uint32_t i = 0; i < *glyphCount; i++) {
+    counts[pages[i]]++;
+  }
+
+  *batchCount = 0;
+  uint32_t offsets[MAX_FONT_PAGES];
+  for (uint32_t i = 0, start = 0; i < font->pageCount; i++) {
+    offsets[i] = start;
+    if (counts[i] > 0) {
+      batches[(*batchCount)++] = (GlyphBatch) { font->pages[i].material, start, counts[i] };
+      start += counts[i];
+    }
+  }
+
+  if (*batchCount > 1) {
+    GlyphVertex* unsorted = tempAlloc(&state.allocator, *glyphCount * 4 * sizeof(GlyphVertex));
+    memcpy(unsorted, vertices, *glyphCount * 4 * sizeof(GlyphVertex));
+    for (uint32_t i = 0; i < *glyphCount; i++) {
+      memcpy(vertices + 4 * offsets[pages[i]]++, unsorted + 4 * i, 4 * sizeof(GlyphVertex));
+    }
+  }
+
+  tempPop(&state.allocator, stack);
+}
+
+static uint64_t hashText(Font* font, ColoredString* strings, uint32_t count, float wrap, HorizontalAlign halign, VerticalAlign valign, bool flip) {
+  float layout[] = { wrap, font->lineSpacing, (float) halign, (float) valign, (float) flip };
+  uint64_t hash = hash64(layout, sizeof(layout));
+  for (uint32_t i = 0; i < count; i++) {
+    uint64_t parts[] = { hash, hash64(strings[i].string, strings[i].length), hash64(strings[i].color, sizeof(strings[i].color)) };
+    hash = hash64(parts, sizeof(parts));
+  }
+  return hash;
+}
+
+// Releases text that hasn't been drawn in a while.  map_t can't remove, so the lookup is rebuilt.
+static void evictText(Font* font) {
+  if (font->textTick == state.tick) return;
+  font->textTick = state.tick;
+
+  size_t kept = 0;
+  for (size_t i = 0; i < font->texts.length; i++) {
+    CachedText* text = &font->texts.data[i];
+    if (state.tick - text->tick > TEXT_CACHE_LIFETIME) {
+      releaseText(text);
+    } else {
+      font->texts.data[kept++] = *text;
+    }
+  }
+
+  if (kept == font->texts.length) return;
+
+  font->texts.length = kept;
+  map_free(&font->textLookup);
+  map_init(&font->textLookup, (uint32_t) kept);
+  for (size_t i = 0; i < kept; i++) {
+    map_set(&font->textLookup, font->texts.data[i].hash, i);
+  }
+}
+
+static CachedText* getCachedText(Font* font, uint64_t hash) {
+  evictText(font);
+  uint64_t index = map_get(&font->textLookup, hash);
+  if (index == MAP_NIL) return NULL;
+  CachedText* text = &font->texts.data[index];
+  text->tick = state.tick;
+
+  // Keeps the pages from getting evicted while the text is in use
+  for (uint32_t i = 0; i < text->batchCount; i++) {
+    for (uint32_t j = 0; j < font->pageCount; j++) {
+      if (font->pages[j].material == text->batches[i].material) {
+        font->pages[j].tick = state.tick;
+      }
+    }
+  }
+
+  return text;
+}
+
+// The first time text is seen its hash goes in a small fixed table of sightings, so text that
+// changes every frame doesn't create a Buffer or a cache entry each time.  Text is only cached
+// when it's seen again before another hash lands in its slot.  Returns NULL if the text shouldn't
+// be drawn from the cache (yet).
+static CachedText* cacheText(Font* font, uint64_t hash, GlyphVertex* vertices, uint32_t glyphCount, uint32_t lineCount, GlyphBatch* batches, uint32_t batchCount) {
+  uint64_t* sighting = &font->textSightings[hash % TEXT_SIGHTING_COUNT];
+
+  if (*sighting != hash) {
+    *sighting = hash;
+    return NULL;
+  }
+
+  if (glyphCount == 0 || glyphCount > MAX_TEXT_GLYPHS) {
+    return NULL;
+  }
+
+  void* data;
+  Buffer* buffer = lovrBufferCreate(&(BufferInfo) {
+    .format = (DataField[]) {
+      { .length = glyphCount * 4, .stride = sizeof(GlyphVertex), .fieldCount = 3 },
+      { .type = TYPE_F32x2, .offset = offsetof(GlyphVertex, position), .hash = LOCATION_POSITION },
+      { .type = TYPE_UN16x2, .offset = offsetof(GlyphVertex, uv), .hash = LOCATION_UV },
+      { .type = TYPE_UN8x4, .offset = offsetof(GlyphVertex, color), .hash = LOCATION_COLOR }
+    }
+  }, &data);
+
+  memcpy(data, vertices, glyphCount * 4 * sizeof(GlyphVertex));
+  GlyphBatch* copy = lovrMalloc(batchCount * sizeof(GlyphBatch));
+  memcpy(copy, batches, batchCount * sizeof(GlyphBatch));
+
+  arr_push(&font->texts, ((CachedText) { hash, buffer, copy, batchCount, glyphCount, lineCount, state.tick }));
+  map_set(&font->textLookup, hash, font->texts.length - 1);
+  return &font->texts.data[font->texts.length - 1];
+}
+
+// Every piece of cached text uses the same index buffer, since glyphs are just a list of quads
+static Buffer* getQuadIndices(uint32_t glyphCount) {
+  if (!state.quadIndices || state.quadIndices->info.format->length < glyphCount * 6) {
+    uint32_t capacity = 256;
+    while (capacity < glyphCount) capacity <<= 1;
+
+    lovrRelease(state.quadIndices, lovrBufferDestroy);
+
+    uint16_t* indices;
+    state.quadIndices = lovrBufferCreate(&(BufferInfo) {
+      .format = &(DataField) { .length = capacity * 6, .stride = 2, .type = TYPE_INDEX16 }
+    }, (void**) &indices);
+
+    for (uint32_t i = 0; i < capacity * 4; i += 4) {
+      uint16_t quad[] = { i + 0, i + 2, i + 1, i + 1, i + 2, i + 3 };
+      memcpy(indices, quad, sizeof(quad));
+      indices += COUNTOF(quad);
+    }
+  }
+
+  return state.quadIndices;
 }
 
 // Mesh
@@ -4330,12 +5588,56 @@ static void lovrMeshFlush(Mesh* mesh) {
 
 // Model
 
-Model* lovrModelCreate(const ModelInfo* info) {
+typedef struct {
+  ModelData* data;
+  uint64_t* order;
+  uint32_t* baseVertex;
+  uint32_t* baseIndex;
+  char* vertexData;
+  char* skinData;
+  char* indexData;
+  uint32_t indexSize;
+} ModelVertexContext;
+
+// Every primitive has its own range of the buffers, so they can be converted in parallel
+static void copyModelVertices(void* arg, uint32_t start, uint32_t count) {
+  ModelVertexContext* ctx = arg;
+  ModelData* data = ctx->data;
+
+  for (uint32_t i = start; i < start + count; i++) {
+    ModelPrimitive* primitive = &data->primitives[ctx->order[i] & ~0u];
+    ModelAttribute** attributes = primitive->attributes;
+    uint32_t vertexCount = attributes[ATTR_POSITION]->count;
+    size_t stride = sizeof(ModelVertex);
+    char* vertexData = ctx->vertexData + ctx->baseVertex[i] * stride;
+
+    lovrModelDataCopyAttribute(data, attributes[ATTR_POSITION], vertexData + 0, F32, 3, false, vertexCount, stride, 0);
+    lovrModelDataCopyAttribute(data, attributes[ATTR_NORMAL], vertexData + 12, SN10x3, 1, false, vertexCount, stride, 0);
+    lovrModelDataCopyAttribute(data, attributes[ATTR_UV], vertexData + 16, F32, 2, false, vertexCount, stride, 0);
+    lovrModelDataCopyAttribute(data, attributes[ATTR_COLOR], vertexData + 24, U8, 4, true, vertexCount, stride, 255);
+    lovrModelDataCopyAttribute(data, attributes[ATTR_TANGENT], vertexData + 28, SN10x3, 1, false, vertexCount, stride, 0);
+
+    // Skinned primitives are sorted first, so their skin data starts at the same index as vertices
+    if (data->skinnedVertexCount > 0 && primitive->skin != ~0u) {
+      char* skinData = ctx->skinData + ctx->baseVertex[i] * 8;
+      lovrModelDataCopyAttribute(data, attributes[ATTR_JOINTS], skinData + 0, U8, 4, false, vertexCount, 8, 0);
+      lovrModelDataCopyAttribute(data, attributes[ATTR_WEIGHTS], skinData + 4, U8, 4, true, vertexCount, 8, 0);
+    }
+
+    if (primitive->indices) {
+      char* indices = data->buffers[primitive->indices->buffer].data + primitive->indices->offset;
+      memcpy(ctx->indexData + ctx->baseIndex[i] * ctx->indexSize, indices, primitive->indices->count * ctx->indexSize);
+    }
+  }
+}
+
+static void popModelStack(void* arg) {
+  tempPop(&state.allocator, *(size_t*) arg);
+}
+
+static void lovrModelInit(Model* model) {
+  const ModelInfo* info = &model->info;
   ModelData* data = info->data;
-  Model* model = lovrCalloc(sizeof(Model));
-  model->ref = 1;
-  model->info = *info;
-  lovrRetain(info->data);
 
   for (uint32_t i = 0; i < data->skinCount; i++) {
     lovrCheck(data->skins[i].jointCount <= 256, "Currently, the max number of joints per skin is 256");
@@ -4344,7 +5646,7 @@ Model* lovrModelCreate(const ModelInfo* info) {
   // Materials and Textures
   if (info->materials) {
     model->textures = lovrCalloc(data->imageCount * sizeof(Texture*));
-    model->materials = lovrMalloc(data->materialCount * sizeof(Material*));
+    model->materials = lovrCalloc(data->materialCount * sizeof(Material*));
     for (uint32_t i = 0; i < data->materialCount; i++) {
       MaterialInfo material;
       ModelMaterial* properties = &data->materials[i];
@@ -4473,9 +5775,12 @@ Model* lovrModelCreate(const ModelInfo* info) {
   // - Then "non-dynamic" primitives follow
   // Within each section primitives are still sorted by their index.
 
+  uint32_t defer = lovrDeferPush();
   size_t stack = tempPush(&state.allocator);
+  lovrErrDefer(popModelStack, &stack);
   uint64_t* primitiveOrder = tempAlloc(&state.allocator, data->primitiveCount * sizeof(uint64_t));
   uint32_t* baseVertex = tempAlloc(&state.allocator, data->primitiveCount * sizeof(uint32_t));
+  uint32_t* baseIndex = tempAlloc(&state.allocator, data->primitiveCount * sizeof(uint32_t));
 
   for (uint32_t i = 0; i < data->primitiveCount; i++) {
     uint32_t hi = data->primitives[i].skin;
@@ -4523,34 +5828,26 @@ Model* lovrModelCreate(const ModelInfo* info) {
     draw->bounds[5] = (position->max[2] - position->min[2]) / 2.f;
 
     baseVertex[i] = vertexCursor;
+    baseIndex[i] = draw->start;
     vertexCursor += position->count;
   }
 
   // Vertices
-  for (uint32_t i = 0; i < data->primitiveCount; i++) {
-    ModelPrimitive* primitive = &data->primitives[primitiveOrder[i] & ~0u];
-    ModelAttribute** attributes = primitive->attributes;
-    uint32_t count = attributes[ATTR_POSITION]->count;
-    size_t stride = sizeof(ModelVertex);
-
-    lovrModelDataCopyAttribute(data, attributes[ATTR_POSITION], vertexData + 0, F32, 3, false, count, stride, 0);
-    lovrModelDataCopyAttribute(data, attributes[ATTR_NORMAL], vertexData + 12, SN10x3, 1, false, count, stride, 0);
-    lovrModelDataCopyAttribute(data, attributes[ATTR_UV], vertexData + 16, F32, 2, false, count, stride, 0);
-    lovrModelDataCopyAttribute(data, attributes[ATTR_COLOR], vertexData + 24, U8, 4, true, count, stride, 255);
-    lovrModelDataCopyAttribute(data, attributes[ATTR_TANGENT], vertexData + 28, SN10x3, 1, false, count, stride, 0);
-    vertexData += count * stride;
-
-    if (data->skinnedVertexCount > 0 && primitive->skin != ~0u) {
-      lovrModelDataCopyAttribute(data, attributes[ATTR_JOINTS], skinData + 0, U8, 4, false, count, 8, 0);
-      lovrModelDataCopyAttribute(data, attributes[ATTR_WEIGHTS], skinData + 4, U8, 4, true, count, 8, 0);
-      skinData += count * 8;
-    }
+  ModelVertexContext vertexContext = {
+    .data = data,
+    .order = primitiveOrder,
+    .baseVertex = baseVertex,
+    .baseIndex = baseIndex,
+    .vertexData = vertexData,
+    .skinData = skinData,
+    .indexData = indexData,
+    .indexSize = indexSize
+  };
 
-    if (primitive->indices) {
-      char* indices = data->buffers[primitive->indices->buffer].data + primitive->indices->offset;
-      memcpy(indexData, indices, primitive->indices->count * indexSize);
-      indexData += primitive->indices->count * indexSize;
-    }
+  if (data->vertexCount >= 65536) {
+    job_parallel_for(data->primitiveCount, 1, copyModelVertices, &vertexContext);
+  } else {
+    copyModelVertices(&vertexContext, 0, data->primitiveCount);
   }
 
   // Blend shapes
@@ -4602,11 +5899,117 @@ Model* lovrModelCreate(const ModelInfo* info) {
   lovrModelResetNodeTransforms(model);
 
   tempPop(&state.allocator, stack);
+  lovrDeferPop(defer);
+}
+
+Model* lovrModelCreate(const ModelInfo* info) {
+  Model* model = lovrCalloc(sizeof(Model));
+  model->ref = 1;
+  model->animationInterval = 1;
+  model->info = *info;
+  lovrRetain(info->data);
+  lovrModelInit(model);
+  return model;
+}
+
+static void loadModel(void* arg) {
+  ModelLoad* load = ((Model*) arg)->load;
+  load->data = lovrModelDataCreate(load->blob, load->io);
+}
+
+static void onModelLoadError(void* arg, const char* format, va_list args) {
+  ModelLoad* load = ((Model*) arg)->load;
+  load->error = lovrMalloc(1024);
+  vsnprintf(load->error, 1024, format, args);
+}
+
+static void loadModelJob(void* arg) {
+  lovrTry(loadModel, arg, onModelLoadError, arg);
+}
+
+static void initModel(void* arg) {
+  lovrModelInit(arg);
+}
+
+static void freeModelLoad(Model* model) {
+  ModelLoad* load = model->load;
+  lovrRelease(load->data, lovrModelDataDestroy);
+  lovrRelease(load->blob, lovrBlobDestroy);
+  lovrFree(load->error);
+  lovrFree(load);
+  model->load = NULL;
+}
+
+// Releases everything lovrModelInit creates, resources that weren't created yet are skipped
+static void freeModelResources(Model* model) {
+  ModelData* data = model->info.data;
+  if (model->materials) {
+    for (uint32_t i = 0; i < data->materialCount; i++) {
+      lovrRelease(model->materials[i], lovrMaterialDestroy);
+    }
+    for (uint32_t i = 0; i < data->imageCount; i++) {
+      lovrRelease(model->textures[i], lovrTextureDestroy);
+    }
+    lovrFree(model->materials);
+    lovrFree(model->textures);
+  }
+  lovrRelease(model->rawVertexBuffer, lovrBufferDestroy);
+  lovrRelease(model->vertexBuffer, lovrBufferDestroy);
+  lovrRelease(model->indexBuffer, lovrBufferDestroy);
+  lovrRelease(model->blendBuffer, lovrBufferDestroy);
+  lovrRelease(model->skinBuffer, lovrBufferDestroy);
+  lovrFree(model->localTransforms);
+  lovrFree(model->globalTransforms);
+  lovrFree(model->boundingBoxes);
+  lovrFree(model->blendShapeWeights);
+  lovrFree(model->blendGroups);
+  lovrFree(model->meshes);
+  lovrFree(model->draws);
+}
+
+// Finishes creating a model once its data is decoded, GPU resources are created on the main thread
+static void waitModel(Model* model) {
+  if (!model->load) {
+    return;
+  }
+
+  job_group_wait(&model->jobs);
+  lovrAssert(!model->load->error, "%s", model->load->error);
+
+  // If initialization fails, the error is kept so the Model stays unusable instead of half-created
+  model->info.data = model->load->data;
+  lovrTry(initModel, model, onModelLoadError, model);
+
+  if (model->load->error) {
+    freeModelResources(model);
+    model->info.data = NULL;
+    lovrThrow("%s", model->load->error);
+  }
 
+  model->load->data = NULL;
+  freeModelLoad(model);
+}
+
+Model* lovrModelCreateAsync(const ModelInfo* info, Blob* blob, ModelDataIO* io) {
+  Model* model = lovrCalloc(sizeof(Model));
+  model->ref = 1;
+  model->animationInterval = 1;
+  model->info = *info;
+  model->info.data = NULL;
+  model->load = lovrCalloc(sizeof(ModelLoad));
+  model->load->blob = blob;
+  model->load->io = io;
+  lovrRetain(blob);
+  job_group_start(&model->jobs, loadModelJob, model);
   return model;
 }
 
+bool lovrModelIsComplete(Model* model) {
+  return !model->load || atomic_load(&model->jobs.pending) == 0;
+}
+
 Model* lovrModelClone(Model* parent) {
+  waitModel(parent);
   ModelData* data = parent->info.data;
   Model* model = lovrCalloc(sizeof(Model));
   model->ref = 1;
@@ -4625,10 +6028,13 @@ Model* lovrModelClone(Model* parent) {
   model->blendGroups = parent->blendGroups;
   model->blendGroupCount = parent->blendGroupCount;
 
+  model->animationInterval = parent->animationInterval;
+
   if (parent->vertexBuffer) {
     model->vertexBuffer = lovrBufferCreate(&parent->vertexBuffer->info, NULL);
 
     beginFrame();
+    flushAnimations();
 
     gpu_barrier barrier = syncTransfer(&parent->vertexBuffer->sync, GPU_PHASE_COPY, GPU_CACHE_TRANSFER_READ);
     gpu_sync(state.stream, &barrier, 1);
@@ -4664,6 +6070,12 @@ Model* lovrModelClone(Model* parent) {
 
 void lovrModelDestroy(void* ref) {
   Model* model = ref;
+  if (model->load) {
+    job_group_wait(&model->jobs);
+    freeModelLoad(model);
+    lovrFree(model);
+    return;
+  }
   if (model->parent) {
     lovrRelease(model->parent, lovrModelDestroy);
     lovrRelease(model->vertexBuffer, lovrBufferDestroy);
@@ -4675,55 +6087,40 @@ void lovrModelDestroy(void* ref) {
     lovrFree(model);
     return;
   }
-  ModelData* data = model->info.data;
-  if (model->info.materials) {
-    for (uint32_t i = 0; i < data->materialCount; i++) {
-      lovrRelease(model->materials[i], lovrMaterialDestroy);
-    }
-    for (uint32_t i = 0; i < data->imageCount; i++) {
-      lovrRelease(model->textures[i], lovrTextureDestroy);
-    }
-    lovrFree(model->materials);
-    lovrFree(model->textures);
-  }
-  lovrRelease(model->rawVertexBuffer, lovrBufferDestroy);
-  lovrRelease(model->vertexBuffer, lovrBufferDestroy);
-  lovrRelease(model->indexBuffer, lovrBufferDestroy);
-  lovrRelease(model->blendBuffer, lovrBufferDestroy);
-  lovrRelease(model->skinBuffer, lovrBufferDestroy);
+  freeModelResources(model);
   lovrRelease(model->info.data, lovrModelDataDestroy);
-  lovrFree(model->localTransforms);
-  lovrFree(model->globalTransforms);
-  lovrFree(model->boundingBoxes);
-  lovrFree(model->blendShapeWeights);
-  lovrFree(model->blendGroups);
-  lovrFree(model->meshes);
-  lovrFree(model->draws);
   lovrFree(model);
 }
 
 const ModelInfo* lovrModelGetInfo(Model* model) {
+  waitModel(model);
   return &model->info;
 }
 
+static void getRestTransform(ModelData* data, uint32_t node, NodeTransform* transform) {
+  if (data->nodes[node].hasMatrix) {
+    mat4_getPosition(data->nodes[node].transform.matrix, transform->position);
+    mat4_getOrientation(data->nodes[node].transform.matrix, transform->rotation);
+    mat4_getScale(data->nodes[node].transform.matrix, transform->scale);
+  } else {
+    vec3_init(transform->position, data->nodes[node].transform.translation);
+    quat_init(transform->rotation, data->nodes[node].transform.rotation);
+    vec3_init(transform->scale, data->nodes[node].transform.scale);
+  }
+}
+
 void lovrModelResetNodeTransforms(Model* model) {
+  waitModel(model);
   ModelData* data = model->info.data;
   for (uint32_t i = 0; i < data->nodeCount; i++) {
-    NodeTransform* transform = &model->localTransforms[i];
-    if (data->nodes[i].hasMatrix) {
-      mat4_getPosition(data->nodes[i].transform.matrix, transform->position);
-      mat4_getOrientation(data->nodes[i].transform.matrix, transform->rotation);
-      mat4_getScale(data->nodes[i].transform.matrix, transform->scale);
-    } else {
-      vec3_init(transform->position, data->nodes[i].transform.translation);
-      quat_init(transform->rotation, data->nodes[i].transform.rotation);
-      vec3_init(transform->scale, data->nodes[i].transform.scale);
-    }
+    getRestTransform(data, i, &model->localTransforms[i]);
   }
   model->transformsDirty = true;
+  model->skinDirty = true;
 }
 
 void lovrModelResetBlendShapes(Model* model) {
+  waitModel(model);
   ModelData* data = model->info.data;
   for (uint32_t i = 0; i < data->blendShapeCount; i++) {
     model->blendShapeWeights[i] = data->blendShapes[i].weight;
@@ -4731,23 +6128,30 @@ void lovrModelResetBlendShapes(Model* model) {
   model->blendShapesDirty = true;
 }
 
-void lovrModelAnimate(Model* model, uint32_t animationIndex, float time, float alpha) {
-  if (alpha <= 0.f) return;
+// Samples an animation into a set of local node transforms and blend shape weights, returning
+// which of them changed.  Doesn't touch any global state, so it's safe to call from workers.  It
+// can still throw: channels wider than 16 floats are sampled into a lovrMalloc buffer, which fails
+// with "Out of memory" (and there's no handler to catch that on a worker).
+enum { SAMPLED_TRANSFORMS = 1, SAMPLED_WEIGHTS = 2 };
 
-  ModelData* data = model->info.data;
-  lovrCheck(animationIndex < data->animationCount, "Invalid animation index '%d' (Model has %d animation%s)", animationIndex + 1, data->animationCount, data->animationCount == 1 ? "" : "s");
-  ModelAnimation* animation = &data->animations[animationIndex];
+static uint32_t sampleAnimation(ModelData* data, ModelAnimation* animation, float time, float alpha, NodeTransform* transforms, float* weights) {
+  uint32_t sampled = 0;
   time = fmodf(time, animation->duration);
 
-  size_t stack = tempPush(&state.allocator);
-
   for (uint32_t i = 0; i < animation->channelCount; i++) {
     ModelAnimationChannel* channel = &animation->channels[i];
     uint32_t node = channel->nodeIndex;
 
+    // Binary search for the first keyframe at or after the time
     uint32_t keyframe = 0;
-    while (keyframe < channel->keyframeCount && channel->times[keyframe] < time) {
-      keyframe++;
+    uint32_t end = channel->keyframeCount;
+    while (keyframe < end) {
+      uint32_t mid = (keyframe + end) / 2;
+      if (channel->times[mid] < time) {
+        keyframe = mid + 1;
+      } else {
+        end = mid;
+      }
     }
 
     size_t n;
@@ -4758,7 +6162,8 @@ void lovrModelAnimate(Model* model, uint32_t animationIndex, float time, float a
       case PROP_WEIGHTS: n = data->nodes[node].blendShapeCount; break;
     }
 
-    float* property = tempAlloc(&state.allocator, n * sizeof(float));
+    float buffer[16];
+    float* property = n <= COUNTOF(buffer) ? buffer : lovrMalloc(n * sizeof(float));
 
     // Handle the first/last keyframe case (no interpolation)
     if (keyframe == 0 || keyframe >= channel->keyframeCount) {
@@ -4800,9 +6205,9 @@ void lovrModelAnimate(Model* model, uint32_t animationIndex, float time, float a
           float z2 = z * z;
           float z3 = z2 * z;
           float a = 2.f * z3 - 3.f * z2 + 1.f;
-          float b = 2.f * z3 - 3.f * z2 + 1.f;
+          float b = (z3 - 2.f * z2 + z) * dt;
           float c = -2.f * z3 + 3.f * z2;
-          float d = (z3 * -z2) * dt;
+          float d = (z3 - z2) * dt;
           for (size_t j = 0; j < n; j++) {
             property[j] = a * p0[j] + b * m0[j] + c * p1[j] + d * m1[j];
           }
@@ -4812,18 +6217,14 @@ void lovrModelAnimate(Model* model, uint32_t animationIndex, float time, float a
       }
     }
 
-    if (channel->property == PROP_WEIGHTS) {
-      model->blendShapesDirty = true;
-    } else {
-      model->transformsDirty = true;
-    }
+    sampled |= channel->property == PROP_WEIGHTS ? SAMPLED_WEIGHTS : SAMPLED_TRANSFORMS;
 
     float* dst;
     switch (channel->property) {
-      case PROP_TRANSLATION: dst = model->localTransforms[node].position; break;
-      case PROP_SCALE: dst = model->localTransforms[node].scale; break;
-      case PROP_ROTATION: dst = model->localTransforms[node].rotation; break;
-      case PROP_WEIGHTS: dst = &model->blendShapeWeights[data->nodes[node].blendShapeIndex]; break;
+      case PROP_TRANSLATION: dst = transforms[node].position; break;
+      case PROP_SCALE: dst = transforms[node].scale; break;
+      case PROP_ROTATION: dst = transforms[node].rotation; break;
+      case PROP_WEIGHTS: dst = &weights[data->nodes[node].blendShapeIndex]; break;
     }
 
     if (alpha >= 1.f) {
@@ -4833,21 +6234,128 @@ void lovrModelAnimate(Model* model, uint32_t animationIndex, float time, float a
         dst[i] += (property[i] - dst[i]) * alpha;
       }
     }
+
+    if (property != buffer) {
+      lovrFree(property);
+    }
+  }
+
+  return sampled;
+}
+
+static void animateModel(Model* model, ModelAnimation* animation, float time, float alpha) {
+  uint32_t sampled = sampleAnimation(model->info.data, animation, time, alpha, model->localTransforms, model->blendShapeWeights);
+
+  if (sampled & SAMPLED_TRANSFORMS) {
+    model->transformsDirty = true;
+    model->skinDirty = true;
+  }
+
+  if (sampled & SAMPLED_WEIGHTS) {
+    model->blendShapesDirty = true;
+  }
+}
+
+void lovrModelAnimate(Model* model, uint32_t animationIndex, float time, float alpha) {
+  waitModel(model);
+  if (alpha <= 0.f) return;
+
+  ModelData* data = model->info.data;
+  lovrCheck(animationIndex < data->animationCount, "Invalid animation index '%d' (Model has %d animation%s)", animationIndex + 1, data->animationCount, data->animationCount == 1 ? "" : "s");
+  animateModel(model, &data->animations[animationIndex], time, alpha);
+}
+
+typedef struct {
+  AnimateInfo* infos;
+  uint32_t* first;
+  uint32_t* next;
+} AnimateContext;
+
+static void animateModels(void* arg, uint32_t start, uint32_t count) {
+  AnimateContext* context = arg;
+  for (uint32_t i = start; i < start + count; i++) {
+    for (uint32_t j = context->first[i]; j != ~0u; j = context->next[j]) {
+      AnimateInfo* info = &context->infos[j];
+      if (info->alpha > 0.f) {
+        animateModel(info->model, &info->model->info.data->animations[info->animation], info->time, info->alpha);
+      }
+    }
+  }
+}
+
+// Each Model is animated by a single worker, applying its animations in the order they were given
+void lovrGraphicsAnimateModels(AnimateInfo* infos, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    waitModel(infos[i].model);
+    ModelData* data = infos[i].model->info.data;
+    uint32_t index = infos[i].animation;
+    lovrCheck(index < data->animationCount, "Invalid animation index '%d' (Model has %d animation%s)", index + 1, data->animationCount, data->animationCount == 1 ? "" : "s");
+  }
+
+  size_t stack = tempPush(&state.allocator);
+  uint32_t* first = tempAlloc(&state.allocator, count * sizeof(uint32_t));
+  uint32_t* last = tempAlloc(&state.allocator, count * sizeof(uint32_t));
+  uint32_t* next = tempAlloc(&state.allocator, count * sizeof(uint32_t));
+  uint32_t modelCount = 0;
+
+  map_t lookup;
+  map_init(&lookup, count);
+
+  for (uint32_t i = 0; i < count; i++) {
+    uint64_t hash = hash64(&infos[i].model, sizeof(Model*));
+    uint64_t index = map_get(&lookup, hash);
+
+    next[i] = ~0u;
+
+    if (index == MAP_NIL) {
+      map_set(&lookup, hash, modelCount);
+      first[modelCount] = last[modelCount] = i;
+      modelCount++;
+    } else {
+      next[last[index]] = i;
+      last[index] = i;
+    }
   }
 
+  map_free(&lookup);
+
+  AnimateContext context = { infos, first, next };
+  job_parallel_for(modelCount, 0, animateModels, &context);
   tempPop(&state.allocator, stack);
 }
 
+void lovrModelGetPose(Model* model, Pose* pose) {
+  waitModel(model);
+  lovrCheck(pose->data == model->info.data, "Pose was not created from this Model's data");
+  memcpy(pose->transforms, model->localTransforms, pose->data->nodeCount * sizeof(NodeTransform));
+  memcpy(pose->weights, model->blendShapeWeights, pose->data->blendShapeCount * sizeof(float));
+}
+
+// Replaces all of the node transforms and blend shape weights at once, so the hierarchy is only
+// updated once no matter how many animations were mixed into the Pose
+void lovrModelSetPose(Model* model, Pose* pose) {
+  waitModel(model);
+  lovrCheck(pose->data == model->info.data, "Pose was not created from this Model's data");
+  memcpy(model->localTransforms, pose->transforms, pose->data->nodeCount * sizeof(NodeTransform));
+  memcpy(model->blendShapeWeights, pose->weights, pose->data->blendShapeCount * sizeof(float));
+  model->transformsDirty = true;
+  model->skinDirty = true;
+  model->blendShapesDirty = pose->data->blendShapeCount > 0;
+}
+
 float lovrModelGetBlendShapeWeight(Model* model, uint32_t index) {
+  waitModel(model);
   return model->blendShapeWeights[index];
 }
 
 void lovrModelSetBlendShapeWeight(Model* model, uint32_t index, float weight) {
+  waitModel(model);
   model->blendShapeWeights[index] = weight;
   model->blendShapesDirty = true;
 }
 
 void lovrModelGetNodeTransform(Model* model, uint32_t node, float position[3], float scale[3], float rotation[4], OriginType origin) {
+  waitModel(model);
   if (origin == ORIGIN_PARENT) {
     vec3_init(position, model->localTransforms[node].position);
     vec3_init(scale, model->localTransforms[node].scale);
@@ -4864,6 +6372,7 @@ void lovrModelGetNodeTransform(Model* model, uint32_t node, float position[3], f
 }
 
 void lovrModelSetNodeTransform(Model* model, uint32_t node, float position[3], float scale[3], float rotation[4], float alpha) {
+  waitModel(model);
   if (alpha <= 0.f) return;
 
   NodeTransform* transform = &model->localTransforms[node];
@@ -4879,17 +6388,21 @@ void lovrModelSetNodeTransform(Model* model, uint32_t node, float position[3], f
   }
 
   model->transformsDirty = true;
+  model->skinDirty = true;
 }
 
 Buffer* lovrModelGetVertexBuffer(Model* model) {
+  waitModel(model);
   return model->rawVertexBuffer;
 }
 
 Buffer* lovrModelGetIndexBuffer(Model* model) {
+  waitModel(model);
   return model->indexBuffer;
 }
 
 Mesh* lovrModelGetMesh(Model* model, uint32_t index) {
+  waitModel(model);
   ModelData* data = model->info.data;
   lovrCheck(index < data->primitiveCount, "Invalid mesh index '%d' (Model has %d mesh%s)", index + 1, data->primitiveCount, data->primitiveCount == 1 ? "" : "es");
 
@@ -4914,12 +6427,14 @@ Mesh* lovrModelGetMesh(Model* model, uint32_t index) {
 }
 
 Texture* lovrModelGetTexture(Model* model, uint32_t index) {
+  waitModel(model);
   ModelData* data = model->info.data;
   lovrCheck(index < data->imageCount, "Invalid texture index '%d' (Model has %d texture%s)", index + 1, data->imageCount, data->imageCount == 1 ? "" : "s");
   return model->textures[index];
 }
 
 Material* lovrModelGetMaterial(Model* model, uint32_t index) {
+  waitModel(model);
   ModelData* data = model->info.data;
   lovrCheck(index < data->materialCount, "Invalid material index '%d' (Model has %d material%s)", index + 1, data->materialCount, data->materialCount == 1 ? "" : "s");
   return model->materials[index];
@@ -4933,7 +6448,11 @@ static void lovrModelAnimateVertices(Model* model) {
 
   beginFrame();
 
-  if ((!blend && !skin) || (!model->transformsDirty && !model->blendShapesDirty) || model->lastVertexAnimation == state.tick) {
+  if ((!blend && !skin) || (!model->skinDirty && !model->blendShapesDirty)) {
+    return;
+  }
+
+  if (model->lastVertexAnimation && state.tick - model->lastVertexAnimation < model->animationInterval) {
     return;
   }
 
@@ -4942,69 +6461,45 @@ static void lovrModelAnimateVertices(Model* model) {
     model->transformsDirty = false;
   }
 
+  uint32_t subgroupSize = state.device.subgroupSize;
+
   if (blend) {
     Shader* shader = lovrGraphicsGetDefaultShader(SHADER_BLENDER);
     uint32_t vertexCount = data->dynamicVertexCount;
     uint32_t blendBufferCursor = 0;
-    uint32_t chunkSize = 64;
+
+    BufferView view = getBuffer(GPU_BUFFER_STREAM, data->blendShapeCount * sizeof(float), state.limits.storageBufferAlign);
+    memcpy(view.pointer, model->blendShapeWeights, data->blendShapeCount * sizeof(float));
 
     gpu_binding bindings[] = {
       { 0, GPU_SLOT_STORAGE_BUFFER, .buffer = { model->rawVertexBuffer->gpu, model->rawVertexBuffer->base, vertexCount * sizeof(ModelVertex) } },
       { 1, GPU_SLOT_STORAGE_BUFFER, .buffer = { model->vertexBuffer->gpu, model->vertexBuffer->base, vertexCount * sizeof(ModelVertex) } },
       { 2, GPU_SLOT_STORAGE_BUFFER, .buffer = { model->blendBuffer->gpu, model->blendBuffer->base, model->blendBuffer->info.size } },
-      { 3, GPU_SLOT_UNIFORM_BUFFER, .buffer = { NULL, 0, chunkSize * sizeof(float) } }
+      { 3, GPU_SLOT_STORAGE_BUFFER, .buffer = { view.buffer, view.offset, view.extent } }
     };
 
-    gpu_compute_begin(state.stream);
-    gpu_bind_pipeline(state.stream, shader->computePipeline, GPU_PIPELINE_COMPUTE);
+    gpu_bundle* bundle = getBundle(shader->layout, bindings, COUNTOF(bindings));
 
     for (uint32_t i = 0; i < model->blendGroupCount; i++) {
       BlendGroup* group = &model->blendGroups[i];
 
-      for (uint32_t j = 0; j < group->count; j += chunkSize) {
-        uint32_t count = MIN(group->count - j, chunkSize);
-        bool first = j == 0;
-
-        BufferView view = getBuffer(GPU_BUFFER_STREAM, chunkSize * sizeof(float), state.limits.uniformBufferAlign);
-        memcpy(view.pointer, model->blendShapeWeights + group->index + j, count * sizeof(float));
-        bindings[3].buffer = (gpu_buffer_binding) { view.buffer, view.offset, view.extent };
-
-        gpu_bundle* bundle = getBundle(shader->layout, bindings, COUNTOF(bindings));
-        uint32_t constants[] = { group->vertexIndex, group->vertexCount, count, blendBufferCursor, first };
-        uint32_t subgroupSize = state.device.subgroupSize;
-
-        gpu_bind_bundles(state.stream, shader->gpu, &bundle, 0, 1, NULL, 0);
-        gpu_push_constants(state.stream, shader->gpu, constants, sizeof(constants));
-        gpu_compute(state.stream, (group->vertexCount + subgroupSize - 1) / subgroupSize, 1, 1);
-
-        if (j + count < group->count) {
-          gpu_sync(state.stream, &(gpu_barrier) {
-            .prev = GPU_PHASE_SHADER_COMPUTE,
-            .next = GPU_PHASE_SHADER_COMPUTE,
-            .flush = GPU_CACHE_STORAGE_WRITE,
-            .clear = GPU_CACHE_STORAGE_READ
-          }, 1);
-        }
+      VertexAnimation animation = {
+        .model = model,
+        .bundle = bundle,
+        .constants = { group->vertexIndex, group->vertexCount, group->count, blendBufferCursor, group->index },
+        .workgroups = (group->vertexCount + subgroupSize - 1) / subgroupSize
+      };
 
-        blendBufferCursor += group->vertexCount * count;
-      }
+      arr_push(&state.animations, animation);
+      lovrRetain(model);
+
+      blendBufferCursor += group->vertexCount * group->count;
     }
 
     model->blendShapesDirty = false;
   }
 
   if (skin) {
-    if (blend) {
-      gpu_sync(state.stream, &(gpu_barrier) {
-        .prev = GPU_PHASE_SHADER_COMPUTE,
-        .next = GPU_PHASE_SHADER_COMPUTE,
-        .flush = GPU_CACHE_STORAGE_WRITE,
-        .clear = GPU_CACHE_STORAGE_READ | GPU_CACHE_STORAGE_WRITE
-      }, 1);
-    } else {
-      gpu_compute_begin(state.stream);
-    }
-
     Shader* shader = lovrGraphicsGetDefaultShader(SHADER_ANIMATOR);
     Buffer* sourceBuffer = blend ? model->vertexBuffer : model->rawVertexBuffer;
 
@@ -5017,8 +6512,6 @@ static void lovrModelAnimateVertices(Model* model) {
       { 3, GPU_SLOT_UNIFORM_BUFFER, .buffer = { NULL, 0, 0 } } // Filled in for each skin
     };
 
-    gpu_bind_pipeline(state.stream, shader->computePipeline, GPU_PIPELINE_COMPUTE);
-
     for (uint32_t i = 0, baseVertex = 0; i < data->skinCount; i++) {
       ModelSkin* skin = &data->skins[i];
 
@@ -5036,20 +6529,89 @@ static void lovrModelAnimateVertices(Model* model) {
       }
 
       gpu_bundle* bundle = getBundle(shader->layout, bindings, COUNTOF(bindings));
-      gpu_bind_bundles(state.stream, shader->gpu, &bundle, 0, 1, NULL, 0);
 
-      uint32_t subgroupSize = state.device.subgroupSize;
       uint32_t maxVerticesPerDispatch = state.limits.workgroupCount[0] * subgroupSize;
       uint32_t verticesRemaining = skin->vertexCount;
 
       while (verticesRemaining > 0) {
         uint32_t vertexCount = MIN(verticesRemaining, maxVerticesPerDispatch);
-        gpu_push_constants(state.stream, shader->gpu, (uint32_t[2]) { baseVertex, vertexCount }, 8);
-        gpu_compute(state.stream, (vertexCount + subgroupSize - 1) / subgroupSize, 1, 1);
+
+        VertexAnimation animation = {
+          .model = model,
+          .bundle = bundle,
+          .constants = { baseVertex, vertexCount },
+          .workgroups = (vertexCount + subgroupSize - 1) / subgroupSize,
+          .skin = true
+        };
+
+        arr_push(&state.animations, animation);
+        lovrRetain(model);
+
         verticesRemaining -= vertexCount;
         baseVertex += vertexCount;
       }
     }
+
+    model->skinDirty = false;
+  }
+
+  model->lastVertexAnimation = state.tick;
+}
+
+// Every queued model is blended, then one barrier, then every model is skinned
+static void flushAnimations(void) {
+  if (state.animations.length == 0) {
+    return;
+  }
+
+  Shader* blender = lovrGraphicsGetDefaultShader(SHADER_BLENDER);
+  Shader* animator = lovrGraphicsGetDefaultShader(SHADER_ANIMATOR);
+  bool blended = false;
+  bool skinned = false;
+
+  gpu_compute_begin(state.stream);
+
+  for (size_t i = 0; i < state.animations.length; i++) {
+    VertexAnimation* animation = &state.animations.data[i];
+
+    if (animation->skin) {
+      continue;
+    }
+
+    if (!blended) {
+      gpu_bind_pipeline(state.stream, blender->computePipeline, GPU_PIPELINE_COMPUTE);
+      blended = true;
+    }
+
+    gpu_bind_bundles(state.stream, blender->gpu, &animation->bundle, 0, 1, NULL, 0);
+    gpu_push_constants(state.stream, blender->gpu, animation->constants, 5 * sizeof(uint32_t));
+    gpu_compute(state.stream, animation->workgroups, 1, 1);
+  }
+
+  for (size_t i = 0; i < state.animations.length; i++) {
+    VertexAnimation* animation = &state.animations.data[i];
+
+    if (!animation->skin) {
+      continue;
+    }
+
+    if (!skinned) {
+      if (blended) {
+        gpu_sync(state.stream, &(gpu_barrier) {
+          .prev = GPU_PHASE_SHADER_COMPUTE,
+          .next = GPU_PHASE_SHADER_COMPUTE,
+          .flush = GPU_CACHE_STORAGE_WRITE,
+          .clear = GPU_CACHE_STORAGE_READ | GPU_CACHE_STORAGE_WRITE
+        }, 1);
+      }
+
+      gpu_bind_pipeline(state.stream, animator->computePipeline, GPU_PIPELINE_COMPUTE);
+      skinned = true;
+    }
+
+    gpu_bind_bundles(state.stream, animator->gpu, &animation->bundle, 0, 1, NULL, 0);
+    gpu_push_constants(state.stream, animator->gpu, animation->constants, 2 * sizeof(uint32_t));
+    gpu_compute(state.stream, animation->workgroups, 1, 1);
   }
 
   gpu_compute_end(state.stream);
@@ -5058,13 +6620,145 @@ static void lovrModelAnimateVertices(Model* model) {
   state.barrier.next |= GPU_PHASE_INPUT_VERTEX;
   state.barrier.flush |= GPU_CACHE_STORAGE_WRITE;
   state.barrier.clear |= GPU_CACHE_VERTEX;
-  model->lastVertexAnimation = state.tick;
+
+  for (size_t i = 0; i < state.animations.length; i++) {
+    lovrRelease(state.animations.data[i].model, lovrModelDestroy);
+  }
+
+  arr_clear(&state.animations);
+}
+
+uint32_t lovrModelGetAnimationInterval(Model* model) {
+  return model->animationInterval;
+}
+
+void lovrModelSetAnimationInterval(Model* model, uint32_t interval) {
+  lovrCheck(interval > 0, "Animation interval must be at least 1");
+  model->animationInterval = interval;
+}
+
+// Pose
+
+// Poses only touch their own arrays and their ModelData, never the graphics state, so they can be
+// created, sampled, and blended on other threads (which can require lovr.graphics without it being
+// initialized) and sent back to the main thread for Model:setPose.
+
+Pose* lovrPoseCreate(ModelData* data) {
+  Pose* pose = lovrCalloc(sizeof(Pose));
+  pose->ref = 1;
+  pose->data = data;
+  pose->transforms = lovrMalloc(MAX(data->nodeCount, 1) * sizeof(NodeTransform));
+  pose->weights = lovrMalloc(MAX(data->blendShapeCount, 1) * sizeof(float));
+  lovrRetain(data);
+  lovrPoseReset(pose);
+  return pose;
+}
+
+void lovrPoseDestroy(void* ref) {
+  Pose* pose = ref;
+  lovrRelease(pose->data, lovrModelDataDestroy);
+  lovrFree(pose->transforms);
+  lovrFree(pose->weights);
+  lovrFree(pose);
+}
+
+ModelData* lovrPoseGetModelData(Pose* pose) {
+  return pose->data;
+}
+
+void lovrPoseReset(Pose* pose) {
+  ModelData* data = pose->data;
+  for (uint32_t i = 0; i < data->nodeCount; i++) {
+    getRestTransform(data, i, &pose->transforms[i]);
+  }
+  for (uint32_t i = 0; i < data->blendShapeCount; i++) {
+    pose->weights[i] = data->blendShapes[i].weight;
+  }
+}
+
+void lovrPoseCopy(Pose* pose, Pose* source) {
+  lovrCheck(source->data == pose->data, "Poses must be created from the same model data");
+  memcpy(pose->transforms, source->transforms, pose->data->nodeCount * sizeof(NodeTransform));
+  memcpy(pose->weights, source->weights, pose->data->blendShapeCount * sizeof(float));
+}
+
+void lovrPoseSample(Pose* pose, uint32_t animationIndex, float time, float alpha) {
+  ModelData* data = pose->data;
+  lovrCheck(animationIndex < data->animationCount, "Invalid animation index '%d' (Model has %d animation%s)", animationIndex + 1, data->animationCount, data->animationCount == 1 ? "" : "s");
+  if (alpha <= 0.f) return;
+  sampleAnimation(data, &data->animations[animationIndex], time, alpha, pose->transforms, pose->weights);
+}
+
+// A NULL mask affects every node, otherwise only the listed nodes (and their blend shapes) change
+void lovrPoseBlend(Pose* pose, Pose* source, float alpha, uint32_t* mask, uint32_t maskCount) {
+  ModelData* data = pose->data;
+  lovrCheck(source->data == data, "Poses must be created from the same model data");
+  if (alpha <= 0.f) return;
+
+  uint32_t count = mask ? maskCount : data->nodeCount;
+
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t node = mask ? mask[i] : i;
+    lovrCheck(node < data->nodeCount, "Invalid node index '%d'", node + 1);
+    NodeTransform* dst = &pose->transforms[node];
+    NodeTransform* src = &source->transforms[node];
+    float* weights = pose->weights + data->nodes[node].blendShapeIndex;
+    float* targets = source->weights + data->nodes[node].blendShapeIndex;
+    uint32_t weightCount = data->nodes[node].blendShapeCount;
+
+    if (alpha >= 1.f) {
+      *dst = *src;
+      memcpy(weights, targets, weightCount * sizeof(float));
+    } else {
+      vec3_lerp(dst->position, src->position, alpha);
+      quat_slerp(dst->rotation, src->rotation, alpha);
+      vec3_lerp(dst->scale, src->scale, alpha);
+      for (uint32_t j = 0; j < weightCount; j++) {
+        weights[j] += (targets[j] - weights[j]) * alpha;
+      }
+    }
+  }
+}
+
+// Layers the difference between the source and the rest pose on top of this one
+void lovrPoseAdd(Pose* pose, Pose* source, float alpha, uint32_t* mask, uint32_t maskCount) {
+  ModelData* data = pose->data;
+  lovrCheck(source->data == data, "Poses must be created from the same model data");
+  if (alpha == 0.f) return;
+
+  uint32_t count = mask ? maskCount : data->nodeCount;
+
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t node = mask ? mask[i] : i;
+    lovrCheck(node < data->nodeCount, "Invalid node index '%d'", node + 1);
+    NodeTransform* dst = &pose->transforms[node];
+    NodeTransform* src = &source->transforms[node];
+    NodeTransform rest;
+    getRestTransform(data, node, &rest);
+
+    for (uint32_t j = 0; j < 3; j++) {
+      dst->position[j] += (src->position[j] - rest.position[j]) * alpha;
+      dst->scale[j] *= 1.f + (rest.scale[j] == 0.f ? 0.f : src->scale[j] / rest.scale[j] - 1.f) * alpha;
+    }
+
+    float delta[4];
+    quat_conjugate(rest.rotation);
+    quat_mul(delta, rest.rotation, src->rotation);
+    quat_slerp(quat_identity(rest.rotation), delta, alpha);
+    quat_normalize(quat_mul(dst->rotation, dst->rotation, rest.rotation));
+
+    uint32_t first = data->nodes[node].blendShapeIndex;
+    for (uint32_t j = first; j < first + data->nodes[node].blendShapeCount; j++) {
+      pose->weights[j] += (source->weights[j] - data->blendShapes[j].weight) * alpha;
+    }
+  }
 }
 
 // Readback
 
 static Readback* lovrReadbackCreate(ReadbackType type) {
   beginFrame();
+  flushAnimations();
   Readback* readback = lovrCalloc(sizeof(Readback));
   readback->ref = 1;
   readback->tick = state.tick;
@@ -5311,6 +7005,9 @@ void lovrPassReset(Pass* pass) {
   pass->tally.active = false;
   pass->tally.count = 0;
 
+  pass->stats.textCacheHits = 0;
+  pass->stats.textCacheMisses = 0;
+
   pass->transformIndex = 0;
   mat4_identity(pass->transform);
 
@@ -5351,6 +7048,22 @@ void lovrPassReset(Pass* pass) {
   pass->sampler = NULL;
 }
 
+bool lovrPassGetSorting(Pass* pass) {
+  return pass->sorting;
+}
+
+void lovrPassSetSorting(Pass* pass, bool sort) {
+  pass->sorting = sort;
+}
+
+bool lovrPassGetBatching(Pass* pass) {
+  return pass->batching;
+}
+
+void lovrPassSetBatching(Pass* pass, bool batch) {
+  pass->batching = batch;
+}
+
 const PassStats* lovrPassGetStats(Pass* pass) {
   pass->stats.draws = pass->drawCount;
   pass->stats.computes = pass->computeCount;
@@ -5731,6 +7444,8 @@ void lovrPassSetShader(Pass* pass, Shader* shader) {
   }
 
   if (shader) {
+    waitShader(shader);
+
     gpu_binding bindings[32];
 
     // Ensure there's a valid binding for every resource in the new shader.  If the old shader had a
@@ -5799,10 +7514,9 @@ void lovrPassSetShader(Pass* pass, Shader* shader) {
       pass->flags |= DIRTY_UNIFORMS;
     }
 
-    // Custom vertex attributes must be reset: their locations may differ even if the names match
-    if (shader->hasCustomAttributes) {
-      pass->pipeline->lastVertexBuffer = NULL;
-    }
+    // Vertex attributes must be reset: their locations may differ even if the names match
+    pass->pipeline->lastVertexBuffer = NULL;
+    pass->pipeline->lastVertexShader = NULL;
 
     pass->pipeline->info.shader = shader->gpu;
     pass->pipeline->info.flags = shader->flags;
@@ -5965,6 +7679,22 @@ void lovrPassSendData(Pass* pass, const char* name, size_t length, void** data,
   *format = resource->format;
 }
 
+static bool sameVertexFormat(const DataField* a, const DataField* b) {
+  if (a->stride != b->stride || a->fieldCount != b->fieldCount) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < MAX(a->fieldCount, 1); i++) {
+    const DataField* x = a->fieldCount > 0 ? &a->fields[i] : a;
+    const DataField* y = b->fieldCount > 0 ? &b->fields[i] : b;
+    if (x->type != y->type || x->offset != y->offset || x->hash != y->hash) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 static void lovrPassResolvePipeline(Pass* pass, DrawInfo* info, Draw* draw, Draw* prev) {
   Pipeline* pipeline = pass->pipeline;
   Shader* shader = draw->shader;
@@ -5981,10 +7711,15 @@ static void lovrPassResolvePipeline(Pass* pass, DrawInfo* info, Draw* draw, Draw
     pipeline->dirty = true;
   }
 
-  // Vertex formats
-  if (info->vertex.buffer && pipeline->lastVertexBuffer != info->vertex.buffer) {
+  // Vertex formats (buffers with the same layout, like cached text, don't need new attributes as
+  // long as the attributes were built for the same shader)
+  bool sameShader = pipeline->lastVertexShader == shader;
+  if (info->vertex.buffer && pipeline->lastVertexBuffer && sameShader && pipeline->lastVertexBuffer != info->vertex.buffer && sameVertexFormat(pipeline->lastVertexBuffer->info.format, info->vertex.buffer->info.format)) {
+    pipeline->lastVertexBuffer = info->vertex.buffer;
+  } else if (info->vertex.buffer && (pipeline->lastVertexBuffer != info->vertex.buffer || !sameShader)) {
     pipeline->lastVertexFormat = ~0u;
     pipeline->lastVertexBuffer = info->vertex.buffer;
+    pipeline->lastVertexShader = shader;
     pipeline->dirty = true;
 
     const DataField* format = info->vertex.buffer->info.format;
@@ -7017,49 +8752,86 @@ void lovrPassTorus(Pass* pass, float* transform, uint32_t segmentsT, uint32_t se
 void lovrPassText(Pass* pass, ColoredString* strings, uint32_t count, float* transform, float wrap, HorizontalAlign halign, VerticalAlign valign) {
   Font* font = pass->pipeline->font ? pass->pipeline->font : lovrGraphicsGetDefaultFont();
 
-  size_t totalLength = 0;
-  for (uint32_t i = 0; i < count; i++) {
-    totalLength += strings[i].length;
-  }
-
-  size_t stack = tempPush(&state.allocator);
-  GlyphVertex* vertices = tempAlloc(&state.allocator, totalLength * 4 * sizeof(GlyphVertex));
-  uint32_t glyphCount;
-  uint32_t lineCount;
-
   float leading = lovrRasterizerGetLeading(font->info.rasterizer) * font->lineSpacing;
   float ascent = lovrRasterizerGetAscent(font->info.rasterizer);
   float scale = 1.f / font->pixelDensity;
   wrap /= scale;
 
-  Material* material;
   bool flip = pass->cameras[(pass->cameraCount - 1) * pass->canvas.views].projection[5] > 0.f;
-  lovrFontGetVertices(font, strings, count, wrap, halign, valign, vertices, &glyphCount, &lineCount, &material, flip);
+  uint64_t hash = hashText(font, strings, count, wrap, halign, valign, flip);
+  CachedText* text = getCachedText(font, hash);
+
+  size_t stack = tempPush(&state.allocator);
+  GlyphVertex* vertices = NULL;
+  GlyphBatch stackBatches[MAX_FONT_PAGES];
+  GlyphBatch* batches = stackBatches;
+  uint32_t batchCount;
+  uint32_t glyphCount;
+  uint32_t lineCount;
+
+  if (text) {
+    batches = text->batches;
+    batchCount = text->batchCount;
+    glyphCount = text->glyphCount;
+    lineCount = text->lineCount;
+    pass->stats.textCacheHits++;
+  } else {
+    size_t totalLength = 0;
+    for (uint32_t i = 0; i < count; i++) {
+      totalLength += strings[i].length;
+    }
+
+    vertices = tempAlloc(&state.allocator, totalLength * 4 * sizeof(GlyphVertex));
+    lovrFontGetVertices(font, strings, count, wrap, halign, valign, vertices, &glyphCount, &lineCount, batches, &batchCount, flip);
+    text = cacheText(font, hash, vertices, glyphCount, lineCount, batches, batchCount);
+    pass->stats.textCacheMisses++;
+  }
 
   mat4_scale(transform, scale, scale, scale);
   float offset = -ascent + valign / 2.f * (leading * lineCount);
   mat4_translate(transform, 0.f, flip ? -offset : offset, 0.f);
 
-  GlyphVertex* vertexPointer;
-  uint16_t* indices;
-  lovrPassDraw(pass, &(DrawInfo) {
-    .mode = DRAW_TRIANGLES,
-    .shader = lovrRasterizerGetType(font->info.rasterizer) == RASTERIZER_TTF ? SHADER_FONT : SHADER_UNLIT,
-    .material = font->material,
-    .transform = transform,
-    .vertex.format = VERTEX_GLYPH,
-    .vertex.pointer = (void**) &vertexPointer,
-    .vertex.count = glyphCount * 4,
-    .index.pointer = (void**) &indices,
-    .index.count = glyphCount * 6
-  });
+  DefaultShader shader = lovrRasterizerGetType(font->info.rasterizer) == RASTERIZER_TTF ? SHADER_FONT : SHADER_UNLIT;
+
+  // One draw per atlas page
+  for (uint32_t i = 0; i < batchCount; i++) {
+    GlyphBatch* batch = &batches[i];
+
+    if (text) {
+      lovrPassDraw(pass, &(DrawInfo) {
+        .mode = DRAW_TRIANGLES,
+        .shader = shader,
+        .material = batch->material,
+        .transform = transform,
+        .vertex.buffer = text->vertices,
+        .index.buffer = getQuadIndices(batch->count),
+        .index.count = batch->count * 6,
+        .baseVertex = batch->start * 4
+      });
+      continue;
+    }
+
+    GlyphVertex* vertexPointer;
+    uint16_t* indices;
+    lovrPassDraw(pass, &(DrawInfo) {
+      .mode = DRAW_TRIANGLES,
+      .shader = shader,
+      .material = batch->material,
+      .transform = transform,
+      .vertex.format = VERTEX_GLYPH,
+      .vertex.pointer = (void**) &vertexPointer,
+      .vertex.count = batch->count * 4,
+      .index.pointer = (void**) &indices,
+      .index.count = batch->count * 6
+    });
 
-  memcpy(vertexPointer, vertices, glyphCount * 4 * sizeof(GlyphVertex));
+    memcpy(vertexPointer, vertices + batch->start * 4, batch->count * 4 * sizeof(GlyphVertex));
 
-  for (uint32_t i = 0; i < glyphCount * 4; i += 4) {
-    uint16_t quad[] = { i + 0, i + 2, i + 1, i + 1, i + 2, i + 3 };
-    memcpy(indices, quad, sizeof(quad));
-    indices += COUNTOF(quad);
+    for (uint32_t j = 0; j < batch->count * 4; j += 4) {
+      uint16_t quad[] = { j + 0, j + 2, j + 1, j + 1, j + 2, j + 3 };
+      memcpy(indices, quad, sizeof(quad));
+      indices += COUNTOF(quad);
+    }
   }
 
   tempPop(&state.allocator, stack);
@@ -7158,6 +8930,11 @@ static void drawNode(Pass* pass, Model* model, uint32_t index, uint32_t instance
 }
 
 void lovrPassDrawModel(Pass* pass, Model* model, float* transform, uint32_t instances) {
+  if (!lovrModelIsComplete(model)) {
+    return;
+  }
+
+  waitModel(model);
   lovrModelAnimateVertices(model);
 
   if (model->transformsDirty) {
@@ -7392,6 +9169,26 @@ static gpu_pipeline* getPipeline(uint32_t index) {
   return (gpu_pipeline*) ((char*) state.pipelines + index * gpu_sizeof_pipeline());
 }
 
+// Waits for pipeline warmup jobs and makes their pipelines available, failed ones are retried here
+// so the error is reported on the main thread
+static void finishWarmup(void) {
+  job_group_wait(&state.warmup);
+
+  while (state.warmups.length > 0) {
+    PipelineWarmup* warmup = arr_pop(&state.warmups);
+
+    if (warmup->failed) {
+      gpu_pipeline_init_graphics(getPipeline(warmup->index), &warmup->info);
+    }
+
+    map_set(&state.pipelineLookup, warmup->hash, warmup->index);
+    lovrFree(warmup->info.flags);
+    lovrFree((char*) warmup->info.label);
+    lovrRelease(warmup->shader, lovrShaderDestroy);
+    lovrFree(warmup);
+  }
+}
+
 static BufferBlock* getBlock(gpu_buffer_type type, uint32_t size) {
   BufferBlock* block = state.bufferAllocators[type].freelist;
 
@@ -7484,8 +9281,8 @@ static void beginFrame(void) {
 // When a Texture is garbage collected, if it has any transfer operations recorded to state.stream,
 // those transfers need to be submitted before it gets destroyed.  The allocator offset is saved and
 // restored, which is pretty gross, but we don't want to invalidate temp memory (currently this is
-// only a problem for Font: when the font's atlas gets destroyed, it could invalidate the temp
-// memory used by Font:getLines and Pass:text).
+// only a problem for Font: when one of the font's atlas pages gets destroyed, it could invalidate
+// the temp memory used by Font:getLines and Pass:text).
 static void flushTransfers(void) {
   if (state.active) {
     size_t cursor = state.allocator.cursor;
@@ -17,6 +17,7 @@ typedef struct Material Material;
 typedef struct Font Font;
 typedef struct Mesh Mesh;
 typedef struct Model Model;
+typedef struct Pose Pose;
 typedef struct Readback Readback;
 typedef struct Pass Pass;
 
@@ -27,6 +28,8 @@ typedef struct {
   bool antialias;
   void* cacheData;
   size_t cacheSize;
+  void* spirvCacheData;
+  size_t spirvCacheSize;
 } GraphicsConfig;
 
 typedef struct {
@@ -98,6 +101,8 @@ void lovrGraphicsGetFeatures(GraphicsFeatures* features);
 void lovrGraphicsGetLimits(GraphicsLimits* limits);
 uint32_t lovrGraphicsGetFormatSupport(uint32_t format, uint32_t features);
 void lovrGraphicsGetShaderCache(void* data, size_t* size);
+bool lovrGraphicsIsSpirvCacheDirty(void);
+void lovrGraphicsGetSpirvCache(void* data, size_t* size);
 
 void lovrGraphicsGetBackgroundColor(float background[4]);
 void lovrGraphicsSetBackgroundColor(float background[4]);
@@ -107,6 +112,8 @@ void lovrGraphicsSetTimingEnabled(bool enable);
 void lovrGraphicsSubmit(Pass** passes, uint32_t count);
 void lovrGraphicsPresent(void);
 void lovrGraphicsWait(void);
+void lovrGraphicsPrewarm(Pass** passes, uint32_t count);
+bool lovrGraphicsIsPrewarming(void);
 
 // Buffer
 
@@ -328,8 +335,10 @@ void lovrGraphicsCompileShader(ShaderSource* stages, ShaderSource* outputs, uint
 ShaderSource lovrGraphicsGetDefaultShaderSource(DefaultShader type, ShaderStage stage);
 Shader* lovrGraphicsGetDefaultShader(DefaultShader type);
 Shader* lovrShaderCreate(const ShaderInfo* info);
+Shader* lovrShaderCreateAsync(const ShaderInfo* info, ShaderIncluder* io);
 Shader* lovrShaderClone(Shader* parent, ShaderFlag* flags, uint32_t count);
 void lovrShaderDestroy(void* ref);
+bool lovrShaderIsComplete(Shader* shader);
 const ShaderInfo* lovrShaderGetInfo(Shader* shader);
 bool lovrShaderHasStage(Shader* shader, ShaderStage stage);
 bool lovrShaderHasAttribute(Shader* shader, const char* name, uint32_t location);
@@ -399,6 +408,14 @@ typedef struct {
   struct { uint8_t r, g, b, a; } color;
 } GlyphVertex;
 
+#define MAX_FONT_PAGES 16
+
+typedef struct {
+  Material* material;
+  uint32_t start;
+  uint32_t count;
+} GlyphBatch;
+
 Font* lovrGraphicsGetDefaultFont(void);
 Font* lovrFontCreate(const FontInfo* info);
 void lovrFontDestroy(void* ref);
@@ -407,10 +424,13 @@ float lovrFontGetPixelDensity(Font* font);
 void lovrFontSetPixelDensity(Font* font, float pixelDensity);
 float lovrFontGetLineSpacing(Font* font);
 void lovrFontSetLineSpacing(Font* font, float spacing);
+void lovrFontPreload(Font* font, uint32_t* codepoints, uint32_t count);
+struct Blob* lovrFontGetAtlasCache(Font* font);
+bool lovrFontSetAtlasCache(Font* font, struct Blob* blob);
 float lovrFontGetKerning(Font* font, uint32_t first, uint32_t second);
 float lovrFontGetWidth(Font* font, ColoredString* strings, uint32_t count);
 void lovrFontGetLines(Font* font, ColoredString* strings, uint32_t count, float wrap, void (*callback)(void* context, const char* string, size_t length), void* context);
-void lovrFontGetVertices(Font* font, ColoredString* strings, uint32_t count, float wrap, HorizontalAlign halign, VerticalAlign valign, GlyphVertex* vertices, uint32_t* glyphCount, uint32_t* lineCount, Material** material, bool flip);
+void lovrFontGetVertices(Font* font, ColoredString* strings, uint32_t count, float wrap, HorizontalAlign halign, VerticalAlign valign, GlyphVertex* vertices, uint32_t* glyphCount, uint32_t* lineCount, GlyphBatch* batches, uint32_t* batchCount, bool flip);
 
 // Mesh
 
@@ -465,13 +485,27 @@ typedef enum {
   ORIGIN_PARENT
 } OriginType;
 
+typedef struct {
+  Model* model;
+  uint32_t animation;
+  float time;
+  float alpha;
+} AnimateInfo;
+
 Model* lovrModelCreate(const ModelInfo* info);
+Model* lovrModelCreateAsync(const ModelInfo* info, struct Blob* blob, void* io(const char* filename, size_t* bytesRead));
 Model* lovrModelClone(Model* model);
 void lovrModelDestroy(void* ref);
+bool lovrModelIsComplete(Model* model);
 const ModelInfo* lovrModelGetInfo(Model* model);
 void lovrModelResetNodeTransforms(Model* model);
 void lovrModelResetBlendShapes(Model* model);
 void lovrModelAnimate(Model* model, uint32_t animationIndex, float time, float alpha);
+void lovrGraphicsAnimateModels(AnimateInfo* infos, uint32_t count);
+uint32_t lovrModelGetAnimationInterval(Model* model);
+void lovrModelSetAnimationInterval(Model* model, uint32_t interval);
+void lovrModelGetPose(Model* model, Pose* pose);
+void lovrModelSetPose(Model* model, Pose* pose);
 float lovrModelGetBlendShapeWeight(Model* model, uint32_t index);
 void lovrModelSetBlendShapeWeight(Model* model, uint32_t index, float weight);
 void lovrModelGetNodeTransform(Model* model, uint32_t node, float* position, float* scale, float* rotation, OriginType origin);
@@ -482,6 +516,17 @@ Mesh* lovrModelGetMesh(Model* model, uint32_t index);
 Texture* lovrModelGetTexture(Model* model, uint32_t index);
 Material* lovrModelGetMaterial(Model* model, uint32_t index);
 
+// Pose
+
+Pose* lovrPoseCreate(struct ModelData* data);
+void lovrPoseDestroy(void* ref);
+struct ModelData* lovrPoseGetModelData(Pose* pose);
+void lovrPoseReset(Pose* pose);
+void lovrPoseCopy(Pose* pose, Pose* source);
+void lovrPoseSample(Pose* pose, uint32_t animationIndex, float time, float alpha);
+void lovrPoseBlend(Pose* pose, Pose* source, float alpha, uint32_t* mask, uint32_t maskCount);
+void lovrPoseAdd(Pose* pose, Pose* source, float alpha, uint32_t* mask, uint32_t maskCount);
+
 // Readback
 
 Readback* lovrReadbackCreateBuffer(Buffer* buffer, uint32_t offset, uint32_t extent);
@@ -499,6 +544,13 @@ typedef struct {
   uint32_t draws;
   uint32_t computes;
   uint32_t drawsCulled;
+  uint32_t pipelineBinds;
+  uint32_t bundleBinds;
+  uint32_t drawCalls;
+  uint32_t pipelineWaits;
+  uint32_t pipelinesCreated;
+  uint32_t textCacheHits;
+  uint32_t textCacheMisses;
   size_t cpuMemoryReserved;
   size_t cpuMemoryUsed;
   double submitTime;
@@ -563,6 +615,10 @@ Pass* lovrGraphicsGetWindowPass(void);
 Pass* lovrPassCreate(void);
 void lovrPassDestroy(void* ref);
 void lovrPassReset(Pass* pass);
+bool lovrPassGetSorting(Pass* pass);
+void lovrPassSetSorting(Pass* pass, bool sort);
+bool lovrPassGetBatching(Pass* pass);
+void lovrPassSetBatching(Pass* pass, bool batch);
 const PassStats* lovrPassGetStats(Pass* pass);
 
 void lovrPassGetCanvas(Pass* pass, Texture* color[4], Texture** depthTexture, uint32_t* depthFormat, uint32_t* samples);
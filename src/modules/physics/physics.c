@@ -1,6 +1,8 @@
 #include "physics/physics.h"
+#include "core/job.h"
 #include "core/maf.h"
 #include "util.h"
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <threads.h>
 #include <joltc.h>
@@ -13,11 +15,29 @@ struct Contact {
   JPH_ContactSettings* settings;
 };
 
+#define MAX_PHYSICS_JOBS 1024
+
+typedef struct {
+  JPH_JobFunction* fn;
+  void* arg;
+} PhysicsJob;
+
+// A destroyed collider stays allocated until every snapshot that might list it is rewritten
+typedef struct {
+  Collider* collider;
+  uint32_t snapshotMask;
+} RetiredCollider;
+
 struct World {
   uint32_t ref;
   JPH_PhysicsSystem* system;
+  JPH_JobSystem* jobSystem;
+  job_group jobs;
+  PhysicsJob jobArgs[MAX_PHYSICS_JOBS];
+  atomic_uint jobArgCount;
   JPH_BodyInterface* bodyInterfaceLocked;
   JPH_BodyInterface* bodyInterfaceNoLock;
+  const JPH_BodyLockInterface* bodyLockInterface;
   JPH_BodyActivationListener* activationListener;
   JPH_ObjectLayerPairFilter* objectLayerPairFilter;
   JPH_ContactListener* listener;
@@ -25,9 +45,16 @@ struct World {
   Collider* colliders;
   Collider** activeColliders;
   uint32_t activeColliderCount;
+  WorldSnapshot snapshots[3];
+  uint32_t snapshotBack;
+  atomic_uint snapshotMiddle;
+  uint32_t snapshotFront;
+  arr_t(RetiredCollider) retiredColliders;
   Joint* joints;
   uint32_t jointCount;
   WorldCallbacks callbacks;
+  uint32_t sensorCount;
+  arr_t(TriggerEvent) triggerEvents;
   float defaultLinearDamping;
   float defaultAngularDamping;
   bool defaultIsSleepingAllowed;
@@ -234,11 +261,25 @@ static void onContactPersisted(void* userdata, const JPH_Body* body1, const JPH_
   }
 }
 
+static void pushTriggerEvent(World* world, Collider* a, Collider* b, bool enter) {
+  if (!lovrColliderIsSensor(a) && !lovrColliderIsSensor(b)) return;
+  bool swap = !lovrColliderIsSensor(a);
+  mtx_lock(&world->lock);
+  arr_push(&world->triggerEvents, ((TriggerEvent) { swap ? b : a, swap ? a : b, enter }));
+  mtx_unlock(&world->lock);
+}
+
 static void onContactAdded(void* userdata, const JPH_Body* body1, const JPH_Body* body2, const JPH_ContactManifold* manifold, JPH_ContactSettings* settings) {
   World* world = userdata;
   JPH_BodyID id1 = JPH_Body_GetID(body1);
   JPH_BodyID id2 = JPH_Body_GetID(body2);
 
+  if (world->sensorCount > 0 && !JPH_PhysicsSystem_WereBodiesInContact(world->system, id1, id2)) {
+    Collider* a = (Collider*) (uintptr_t) JPH_Body_GetUserData((JPH_Body*) body1);
+    Collider* b = (Collider*) (uintptr_t) JPH_Body_GetUserData((JPH_Body*) body2);
+    pushTriggerEvent(world, a, b, true);
+  }
+
   if (world->callbacks.enter && !JPH_PhysicsSystem_WereBodiesInContact(world->system, id1, id2)) {
     Collider* a = (Collider*) (uintptr_t) JPH_Body_GetUserData((JPH_Body*) body1);
     Collider* b = (Collider*) (uintptr_t) JPH_Body_GetUserData((JPH_Body*) body2);
@@ -262,7 +303,10 @@ static void onContactRemoved(void* userdata, const JPH_SubShapeIDPair* pair) {
     JPH_BodyInterface* interface = world->bodyInterfaceNoLock;
     Collider* a = (Collider*) (uintptr_t) JPH_BodyInterface_GetUserData(interface, pair->Body1ID);
     Collider* b = (Collider*) (uintptr_t) JPH_BodyInterface_GetUserData(interface, pair->Body2ID);
-    if (a && b) {
+    if (a && b && world->sensorCount > 0) {
+      pushTriggerEvent(world, a, b, false);
+    }
+    if (a && b && world->callbacks.exit) {
       mtx_lock(&world->lock);
       thread.locked = true;
       world->callbacks.exit(world->callbacks.userdata, world, a, b);
@@ -272,6 +316,36 @@ static void onContactRemoved(void* userdata, const JPH_SubShapeIDPair* pair) {
   }
 }
 
+static void queueJob(void* context, JPH_JobFunction* fn, void* arg) {
+  World* world = context;
+  job_group_start(&world->jobs, fn, arg);
+}
+
+static void runJob(void* arg) {
+  PhysicsJob* job = arg;
+  job->fn(job->arg);
+}
+
+// Jolt's args array is temporary, so the jobs are copied into the world (it's reset every step)
+static void queueJobs(void* context, JPH_JobFunction* fn, void** args, uint32_t count) {
+  World* world = context;
+  uint32_t base = atomic_fetch_add(&world->jobArgCount, count);
+
+  if (base + count > MAX_PHYSICS_JOBS) {
+    for (uint32_t i = 0; i < count; i++) {
+      job_group_start(&world->jobs, fn, args[i]);
+    }
+    return;
+  }
+
+  PhysicsJob* jobs = world->jobArgs + base;
+  for (uint32_t i = 0; i < count; i++) {
+    jobs[i] = (PhysicsJob) { fn, args[i] };
+  }
+
+  job_group_start_batch(&world->jobs, runJob, jobs, sizeof(PhysicsJob), count);
+}
+
 bool lovrPhysicsInit(void) {
   if (state.initialized) return false;
   JPH_Init(32 * 1024 * 1024);
@@ -287,12 +361,15 @@ void lovrPhysicsDestroy(void) {
 }
 
 World* lovrWorldCreate(WorldInfo* info) {
+  lovrCheck(!info->snapshots || info->timestep > 0.f, "World snapshots require a fixed timestep");
   World* world = lovrCalloc(sizeof(World));
 
   world->ref = 1;
   world->defaultLinearDamping = .05f;
   world->defaultAngularDamping = .05f;
   world->defaultIsSleepingAllowed = info->allowSleep;
+  arr_init(&world->triggerEvents);
+  arr_init(&world->retiredColliders);
   mtx_init(&world->lock, mtx_plain);
 
   world->tagCount = info->tagCount;
@@ -349,11 +426,28 @@ World* lovrWorldCreate(WorldInfo* info) {
   settings.numPositionSteps = MAX(settings.numPositionSteps, 1);
   JPH_PhysicsSystem_SetPhysicsSettings(world->system, &settings);
 
+  // The calling thread also runs jobs while it waits, so it counts towards the concurrency
+  uint32_t workers = job_get_worker_count();
+  uint32_t threads = info->threadCount == 0 ? workers + 1 : MIN(info->threadCount, workers + 1);
+
+  if (threads > 1) {
+    world->jobSystem = JPH_JobSystemCallback_Create(&(JPH_JobSystemConfig) {
+      .context = world,
+      .queueJob = queueJob,
+      .queueJobs = queueJobs,
+      .maxConcurrency = threads
+    });
+  }
+
   world->bodyInterfaceNoLock = JPH_PhysicsSystem_GetBodyInterfaceNoLock(world->system);
   world->bodyInterfaceLocked = info->threadSafe ?
     JPH_PhysicsSystem_GetBodyInterface(world->system) :
     world->bodyInterfaceNoLock;
 
+  world->bodyLockInterface = info->threadSafe ?
+    JPH_PhysicsSystem_GetBodyLockInterface(world->system) :
+    JPH_PhysicsSystem_GetBodyLockInterfaceNoLock(world->system);
+
   world->timestep = info->timestep;
   world->maxSteps = info->maxSteps;
 
@@ -369,6 +463,20 @@ World* lovrWorldCreate(WorldInfo* info) {
     JPH_PhysicsSystem_SetBodyActivationListener(world->system, world->activationListener);
   }
 
+  if (info->snapshots) {
+    for (uint32_t i = 0; i < COUNTOF(world->snapshots); i++) {
+      WorldSnapshot* snapshot = &world->snapshots[i];
+      snapshot->colliders = lovrMalloc(info->maxColliders * sizeof(Collider*));
+      snapshot->positions = lovrMalloc(info->maxColliders * 3 * sizeof(float));
+      snapshot->orientations = lovrMalloc(info->maxColliders * 4 * sizeof(float));
+      snapshot->transforms = lovrMalloc(info->maxColliders * 16 * sizeof(float));
+    }
+
+    world->snapshotBack = 0;
+    world->snapshotMiddle = 1;
+    world->snapshotFront = 2;
+  }
+
   return world;
 }
 
@@ -393,12 +501,31 @@ void lovrWorldDestruct(World* world) {
   if (world->listener) JPH_ContactListener_Destroy(world->listener);
   JPH_BodyActivationListener_Destroy(world->activationListener);
   lovrFree(world->activeColliders);
+  arr_free(&world->triggerEvents);
+
+  for (size_t i = 0; i < world->retiredColliders.length; i++) {
+    lovrRelease(world->retiredColliders.data[i].collider, lovrColliderDestroy);
+  }
+
+  arr_free(&world->retiredColliders);
+
+  for (uint32_t i = 0; i < COUNTOF(world->snapshots); i++) {
+    lovrFree(world->snapshots[i].colliders);
+    lovrFree(world->snapshots[i].positions);
+    lovrFree(world->snapshots[i].orientations);
+    lovrFree(world->snapshots[i].transforms);
+  }
 
   for (uint32_t i = 0; i < world->tagCount; i++) {
     lovrFree(world->tags[i]);
   }
   mtx_destroy(&world->lock);
 
+  if (world->jobSystem) {
+    job_group_wait(&world->jobs);
+    JPH_JobSystem_Destroy(world->jobSystem);
+  }
+
   JPH_PhysicsSystem_Destroy(world->system);
   world->system = NULL;
 }
@@ -463,9 +590,156 @@ void lovrWorldSetGravity(World* world, float gravity[3]) {
   JPH_PhysicsSystem_SetGravity(world->system, vec3_toJolt(gravity));
 }
 
+// Batches lock all of their bodies at once instead of going through the BodyInterface per body.
+// Inside collision callbacks the bodies are already locked by the simulation.
+
+static JPH_BodyID* getBodyIDs(World* world, Collider** colliders, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    lovrCheck(colliders[i]->world == world, "Collider does not belong to this World");
+  }
+
+  JPH_BodyID* ids = lovrMalloc(count * sizeof(JPH_BodyID));
+  for (uint32_t i = 0; i < count; i++) {
+    ids[i] = colliders[i]->id;
+  }
+  return ids;
+}
+
+static const JPH_BodyLockInterface* getBodyLockInterface(World* world) {
+  return thread.locked ? JPH_PhysicsSystem_GetBodyLockInterfaceNoLock(world->system) : world->bodyLockInterface;
+}
+
+void lovrWorldGetPoses(World* world, Collider** colliders, uint32_t count, float* poses) {
+  JPH_BodyID* ids = getBodyIDs(world, colliders, count);
+  JPH_BodyLockMultiRead* lock = JPH_BodyLockInterface_LockMultiRead(getBodyLockInterface(world), ids, count);
+
+  for (uint32_t i = 0; i < count; i++, poses += 7) {
+    Collider* collider = colliders[i];
+    const JPH_Body* body = JPH_BodyLockMultiRead_GetBody(lock, i);
+
+    JPH_RVec3 position;
+    JPH_Quat orientation;
+    JPH_Body_GetPosition(body, &position);
+    JPH_Body_GetRotation(body, &orientation);
+    vec3_fromJolt(poses + 0, &position);
+    quat_fromJolt(poses + 3, &orientation);
+
+    if (world->timestep > 0.f && collider->activeIndex != ~0u) {
+      vec3_lerp(poses + 0, collider->lastPosition, world->interpolation);
+      quat_slerp(poses + 3, collider->lastOrientation, world->interpolation);
+    }
+  }
+
+  JPH_BodyLockMultiRead_Destroy(lock);
+  lovrFree(ids);
+}
+
+void lovrWorldSetPoses(World* world, Collider** colliders, uint32_t count, float* poses) {
+  lovrCheck(!thread.locked, "Tried to write to a Collider inside a collision callback");
+  JPH_BodyID* ids = getBodyIDs(world, colliders, count);
+  JPH_BodyLockMultiWrite* lock = JPH_BodyLockInterface_LockMultiWrite(world->bodyLockInterface, ids, count);
+
+  for (uint32_t i = 0; i < count; i++, poses += 7) {
+    Collider* collider = colliders[i];
+    JPH_BodyInterface_SetPositionAndRotation(world->bodyInterfaceNoLock, ids[i], vec3_toJolt(poses), quat_toJolt((poses + 3)), JPH_Activation_Activate);
+    vec3_init(collider->lastPosition, poses + 0);
+    quat_init(collider->lastOrientation, poses + 3);
+  }
+
+  JPH_BodyLockMultiWrite_Destroy(lock);
+  lovrFree(ids);
+}
+
+void lovrWorldGetVelocities(World* world, Collider** colliders, uint32_t count, float* velocities) {
+  JPH_BodyID* ids = getBodyIDs(world, colliders, count);
+  JPH_BodyLockMultiRead* lock = JPH_BodyLockInterface_LockMultiRead(getBodyLockInterface(world), ids, count);
+
+  for (uint32_t i = 0; i < count; i++, velocities += 6) {
+    const JPH_Body* body = JPH_BodyLockMultiRead_GetBody(lock, i);
+    JPH_Vec3 linear, angular;
+    JPH_Body_GetLinearVelocity(body, &linear);
+    JPH_Body_GetAngularVelocity(body, &angular);
+    vec3_fromJolt(velocities + 0, &linear);
+    vec3_fromJolt(velocities + 3, &angular);
+  }
+
+  JPH_BodyLockMultiRead_Destroy(lock);
+  lovrFree(ids);
+}
+
+void lovrWorldSetVelocities(World* world, Collider** colliders, uint32_t count, float* velocities) {
+  lovrCheck(!thread.locked, "Tried to write to a Collider inside a collision callback");
+  JPH_BodyID* ids = getBodyIDs(world, colliders, count);
+  JPH_BodyLockMultiWrite* lock = JPH_BodyLockInterface_LockMultiWrite(world->bodyLockInterface, ids, count);
+
+  for (uint32_t i = 0; i < count; i++, velocities += 6) {
+    JPH_BodyInterface_SetLinearAndAngularVelocity(world->bodyInterfaceNoLock, ids[i], vec3_toJolt(velocities), vec3_toJolt((velocities + 3)));
+  }
+
+  JPH_BodyLockMultiWrite_Destroy(lock);
+  lovrFree(ids);
+}
+
+static void stepWorld(World* world, float dt) {
+  // Collision callbacks can throw, and errors can only be caught on the calling thread
+  WorldCallbacks* callbacks = &world->callbacks;
+  bool hasCallbacks = callbacks->filter || callbacks->enter || callbacks->exit || callbacks->contact;
+
+  if (world->jobSystem && !hasCallbacks) {
+    atomic_store(&world->jobArgCount, 0);
+    JPH_PhysicsSystem_Update(world->system, dt, 1, world->jobSystem);
+  } else {
+    JPH_PhysicsSystem_Step(world->system, dt, 1);
+  }
+}
+
+// Snapshots are triple buffered: the update writes to the back snapshot and swaps it with the
+// middle one, and the reader swaps its front snapshot with the middle one when it's fresh.  The
+// update never touches the front snapshot, so a reader can hold onto it for as long as it wants.
+// Destroyed colliders are retired instead of being removed from the snapshots, and released once
+// the update has rewritten every snapshot that could contain them.
+#define SNAPSHOT_FRESH 0x4
+
+static void writeSnapshot(World* world) {
+  uint32_t index = world->snapshotBack;
+  WorldSnapshot* snapshot = &world->snapshots[index];
+  snapshot->count = world->activeColliderCount;
+
+  for (uint32_t i = 0; i < snapshot->count; i++) {
+    Collider* collider = world->activeColliders[i];
+    float* position = snapshot->positions + 3 * i;
+    float* orientation = snapshot->orientations + 4 * i;
+
+    JPH_RVec3 p;
+    JPH_Quat q;
+    JPH_Body_GetPosition(collider->body, &p);
+    JPH_Body_GetRotation(collider->body, &q);
+    vec3_fromJolt(position, &p);
+    quat_fromJolt(orientation, &q);
+    vec3_lerp(position, collider->lastPosition, world->interpolation);
+    quat_slerp(orientation, collider->lastOrientation, world->interpolation);
+
+    mat4_fromPose(snapshot->transforms + 16 * i, position, orientation);
+    snapshot->colliders[i] = collider;
+  }
+
+  for (size_t i = world->retiredColliders.length; i-- > 0;) {
+    RetiredCollider* retired = &world->retiredColliders.data[i];
+    retired->snapshotMask &= ~(1u << index);
+    if (retired->snapshotMask == 0) {
+      lovrRelease(retired->collider, lovrColliderDestroy);
+      arr_splice(&world->retiredColliders, i, 1);
+    }
+  }
+
+  world->snapshotBack = atomic_exchange(&world->snapshotMiddle, index | SNAPSHOT_FRESH) & ~SNAPSHOT_FRESH;
+}
+
 void lovrWorldUpdate(World* world, float dt) {
+  arr_clear(&world->triggerEvents);
+
   if (world->timestep == 0.f) {
-    JPH_PhysicsSystem_Step(world->system, dt, 1);
+    stepWorld(world, dt);
     world->inverseDelta = 1.f / dt;
     return;
   }
@@ -494,10 +768,22 @@ void lovrWorldUpdate(World* world, float dt) {
       world->interpolation = 1.f - fmodf(world->time, world->timestep) / world->timestep;
     }
 
-    JPH_PhysicsSystem_Step(world->system, world->timestep, 1);
+    stepWorld(world, world->timestep);
     world->inverseDelta = 1.f / world->timestep;
     step++;
   }
+
+  if (world->snapshots[0].colliders) {
+    writeSnapshot(world);
+  }
+}
+
+const WorldSnapshot* lovrWorldGetSnapshot(World* world) {
+  if (!world->snapshots[0].colliders) return NULL;
+  if (atomic_load(&world->snapshotMiddle) & SNAPSHOT_FRESH) {
+    world->snapshotFront = atomic_exchange(&world->snapshotMiddle, world->snapshotFront) & ~SNAPSHOT_FRESH;
+  }
+  return &world->snapshots[world->snapshotFront];
 }
 
 typedef struct {
@@ -547,6 +833,32 @@ bool lovrWorldRaycast(World* world, float start[3], float end[3], uint32_t filte
   return JPH_NarrowPhaseQuery_CastRay2(query, origin, dir, raycastCallback, &context, layerFilter, tagFilter, NULL);
 }
 
+typedef struct {
+  World* world;
+  float* rays;
+  uint32_t filter;
+  CastResult* results;
+} RaycastBatch;
+
+static float raycastClosestCallback(void* userdata, CastResult* hit) {
+  *((CastResult*) userdata) = *hit;
+  return hit->fraction;
+}
+
+static void raycastRange(void* arg, uint32_t start, uint32_t count) {
+  RaycastBatch* batch = arg;
+  for (uint32_t i = start; i < start + count; i++) {
+    float* ray = batch->rays + 6 * i;
+    batch->results[i].collider = NULL;
+    lovrWorldRaycast(batch->world, ray, ray + 3, batch->filter, raycastClosestCallback, &batch->results[i]);
+  }
+}
+
+void lovrWorldRaycastBatch(World* world, float* rays, uint32_t count, uint32_t filter, CastResult* results) {
+  RaycastBatch batch = { world, rays, filter, results };
+  job_parallel_for(count, 0, raycastRange, &batch);
+}
+
 static float shapecastCallback(void* arg, JPH_ShapeCastResult* result) {
   CastResult hit;
   CastContext* ctx = arg;
@@ -707,8 +1019,12 @@ bool lovrWorldIsCollisionEnabledBetween(World* world, const char* tag1, const ch
   return JPH_ObjectLayerPairFilterTable_ShouldCollide(world->objectLayerPairFilter, i, j);
 }
 
-void lovrWorldSetCallbacks(World* world, WorldCallbacks* callbacks) {
-  if (!callbacks || (!callbacks->filter && !callbacks->enter && !callbacks->exit && !callbacks->contact)) {
+// The contact listener is shared by the Lua callbacks and sensor tracking
+static void updateContactListener(World* world) {
+  WorldCallbacks* callbacks = &world->callbacks;
+  bool sensors = world->sensorCount > 0;
+
+  if (!sensors && !callbacks->filter && !callbacks->enter && !callbacks->exit && !callbacks->contact) {
     JPH_PhysicsSystem_SetContactListener(world->system, NULL);
   } else {
     if (!world->listener) {
@@ -717,16 +1033,30 @@ void lovrWorldSetCallbacks(World* world, WorldCallbacks* callbacks) {
 
     JPH_ContactListener_SetProcs(world->listener, (JPH_ContactListener_Procs) {
       .OnContactValidate = callbacks->filter ? onContactValidate : NULL,
-      .OnContactAdded = (callbacks->enter || callbacks->contact) ? onContactAdded : NULL,
+      .OnContactAdded = (sensors || callbacks->enter || callbacks->contact) ? onContactAdded : NULL,
       .OnContactPersisted = callbacks->contact ? onContactPersisted : NULL,
-      .OnContactRemoved = callbacks->exit ? onContactRemoved : NULL
+      .OnContactRemoved = (sensors || callbacks->exit) ? onContactRemoved : NULL
     }, world);
 
-    world->callbacks = *callbacks;
     JPH_PhysicsSystem_SetContactListener(world->system, world->listener);
   }
 }
 
+void lovrWorldSetCallbacks(World* world, WorldCallbacks* callbacks) {
+  if (callbacks) {
+    world->callbacks = *callbacks;
+  } else {
+    memset(&world->callbacks, 0, sizeof(WorldCallbacks));
+  }
+
+  updateContactListener(world);
+}
+
+TriggerEvent* lovrWorldGetTriggerEvents(World* world, uint32_t* count) {
+  *count = (uint32_t) world->triggerEvents.length;
+  return world->triggerEvents.data;
+}
+
 // Deprecated
 int lovrWorldGetStepCount(World* world) { return 1; }
 void lovrWorldSetStepCount(World* world, int iterations) {}
@@ -857,6 +1187,25 @@ void lovrColliderDestruct(Collider* collider) {
   // Body
 
   World* world = collider->world;
+
+  for (size_t i = world->triggerEvents.length; i-- > 0;) {
+    TriggerEvent* event = &world->triggerEvents.data[i];
+    if (event->sensor == collider || event->collider == collider) {
+      arr_splice(&world->triggerEvents, i, 1);
+    }
+  }
+
+  if (lovrColliderIsSensor(collider)) {
+    if (--world->sensorCount == 0) {
+      updateContactListener(world);
+    }
+  }
+
+  if (world->snapshots[0].colliders) {
+    lovrRetain(collider);
+    arr_push(&world->retiredColliders, ((RetiredCollider) { collider, (1u << COUNTOF(world->snapshots)) - 1 }));
+  }
+
   JPH_BodyInterface_RemoveBody(world->bodyInterfaceLocked, collider->id);
   JPH_BodyInterface_DestroyBody(world->bodyInterfaceLocked, collider->id);
   collider->body = NULL;
@@ -1226,7 +1575,13 @@ bool lovrColliderIsSensor(Collider* collider) {
 }
 
 void lovrColliderSetSensor(Collider* collider, bool sensor) {
+  if (sensor == lovrColliderIsSensor(collider)) return;
   JPH_Body_SetIsSensor(collider->body, sensor);
+
+  World* world = collider->world;
+  if (sensor ? world->sensorCount++ == 0 : --world->sensorCount == 0) {
+    updateContactListener(world);
+  }
 }
 
 bool lovrColliderIsContinuous(Collider* collider) {
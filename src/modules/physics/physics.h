@@ -51,6 +51,8 @@ typedef struct {
   float restitutionThreshold;
   uint32_t velocitySteps;
   uint32_t positionSteps;
+  uint32_t threadCount;
+  bool snapshots;
   const char* tags[MAX_TAGS];
   uint32_t staticTagMask;
   uint32_t tagCount;
@@ -66,6 +68,25 @@ typedef struct {
 
 typedef CastResult OverlapResult;
 
+// A sensor started or stopped touching another collider during the last update
+typedef struct {
+  Collider* sensor;
+  Collider* collider;
+  bool enter;
+} TriggerEvent;
+
+// Interpolated transforms of the awake colliders, written after each update.  Colliders destroyed
+// since the snapshot was taken are still listed (and stay allocated while they are).  A snapshot
+// stays valid until the next call to lovrWorldGetSnapshot, which should only be called from one
+// thread.
+typedef struct {
+  uint32_t count;
+  Collider** colliders;
+  float* positions;
+  float* orientations;
+  float* transforms;
+} WorldSnapshot;
+
 typedef float CastCallback(void* userdata, CastResult* hit);
 typedef float OverlapCallback(void* userdata, OverlapResult* hit);
 typedef void QueryCallback(void* userdata, Collider* collider);
@@ -82,8 +103,14 @@ Collider* lovrWorldGetColliders(World* world, Collider* collider);
 Joint* lovrWorldGetJoints(World* world, Joint* joint);
 void lovrWorldGetGravity(World* world, float gravity[3]);
 void lovrWorldSetGravity(World* world, float gravity[3]);
+void lovrWorldGetPoses(World* world, Collider** colliders, uint32_t count, float* poses);
+void lovrWorldSetPoses(World* world, Collider** colliders, uint32_t count, float* poses);
+void lovrWorldGetVelocities(World* world, Collider** colliders, uint32_t count, float* velocities);
+void lovrWorldSetVelocities(World* world, Collider** colliders, uint32_t count, float* velocities);
 void lovrWorldUpdate(World* world, float dt);
+const WorldSnapshot* lovrWorldGetSnapshot(World* world);
 bool lovrWorldRaycast(World* world, float start[3], float end[3], uint32_t filter, CastCallback* callback, void* userdata);
+void lovrWorldRaycastBatch(World* world, float* rays, uint32_t count, uint32_t filter, CastResult* results);
 bool lovrWorldShapecast(World* world, Shape* shape, float pose[7], float end[3], uint32_t filter, CastCallback* callback, void* userdata);
 bool lovrWorldOverlapShape(World* world, Shape* shape, float pose[7], uint32_t filter, OverlapCallback* callback, void* userdata);
 bool lovrWorldQueryBox(World* world, float position[3], float size[3], uint32_t filter, QueryCallback* callback, void* userdata);
@@ -92,6 +119,7 @@ void lovrWorldDisableCollisionBetween(World* world, const char* tag1, const char
 void lovrWorldEnableCollisionBetween(World* world, const char* tag1, const char* tag2);
 bool lovrWorldIsCollisionEnabledBetween(World* world, const char* tag1, const char* tag2);
 void lovrWorldSetCallbacks(World* world, WorldCallbacks* callbacks);
+TriggerEvent* lovrWorldGetTriggerEvents(World* world, uint32_t* count);
 
 // Deprecated
 int lovrWorldGetStepCount(World* world);
@@ -166,6 +166,63 @@ const char* lovrThreadGetError(Thread* thread) {
   return thread->error;
 }
 
+// Parallel
+
+typedef struct {
+  RangeFunction* function;
+  Blob* body;
+  Variant* arguments;
+  uint32_t argumentCount;
+  mtx_t lock;
+  char* error;
+} ParallelContext;
+
+static void runRange(void* arg, uint32_t start, uint32_t count) {
+  ParallelContext* context = arg;
+  char* error = context->function(context->body, context->arguments, context->argumentCount, start, count);
+
+  if (error) {
+    mtx_lock(&context->lock);
+    if (!context->error) {
+      context->error = error;
+    } else {
+      lovrFree(error);
+    }
+    mtx_unlock(&context->lock);
+  }
+}
+
+void lovrThreadParallelFor(RangeFunction* function, Blob* body, Variant* arguments, uint32_t argumentCount, uint32_t count, uint32_t grainSize) {
+  lovrCheck(argumentCount <= MAX_THREAD_ARGUMENTS, "Too many arguments (max is %d)", MAX_THREAD_ARGUMENTS);
+
+  ParallelContext context = {
+    .function = function,
+    .body = body,
+    .arguments = arguments,
+    .argumentCount = argumentCount
+  };
+
+  mtx_init(&context.lock, mtx_plain);
+
+  // Each chunk gets its own interpreter, so by default use one chunk per thread
+  if (grainSize == 0) {
+    uint32_t threads = job_get_worker_count() + 1;
+    grainSize = count / threads + (count % threads != 0);
+  }
+
+  job_parallel_for(count, grainSize, runRange, &context);
+
+  mtx_destroy(&context.lock);
+
+  if (context.error) {
+    char message[1024];
+    strncpy(message, context.error, sizeof(message) - 1);
+    message[sizeof(message) - 1] = '\0';
+    lovrFree(context.error);
+    lovrThrow("%s", message);
+  }
+}
+
 // Channel
 
 Channel* lovrChannelCreate(uint64_t hash) {
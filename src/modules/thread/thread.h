@@ -29,6 +29,12 @@ void lovrThreadWait(Thread* thread);
 bool lovrThreadIsRunning(Thread* thread);
 const char* lovrThreadGetError(Thread* thread);
 
+// Parallel
+
+typedef char* RangeFunction(struct Blob* body, struct Variant* arguments, uint32_t argumentCount, uint32_t start, uint32_t count);
+
+void lovrThreadParallelFor(RangeFunction* function, struct Blob* body, struct Variant* arguments, uint32_t argumentCount, uint32_t count, uint32_t grainSize);
+
 // Channel
 
 Channel* lovrChannelCreate(uint64_t hash);
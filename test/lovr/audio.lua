@@ -0,0 +1,123 @@
+group('audio', function()
+  group('render', function()
+    before(function()
+      lovr.audio.stop()
+    end)
+
+    test('silence', function()
+      local output = lovr.data.newSound(1000, 'f32', 'stereo', lovr.audio.getSampleRate())
+      expect(lovr.audio.render(output)).to.be(1000)
+      expect(output:getFrames(1, 500)[1]).to.be(0)
+    end)
+
+    test('Source', function()
+      local rate = lovr.audio.getSampleRate()
+      local input = lovr.data.newSound(rate, 'f32', 'mono', rate)
+      local samples = {}
+      for i = 1, rate do samples[i] = .5 end
+      input:setFrames(samples)
+
+      local source = lovr.audio.newSource(input, { spatial = false, pitchable = false })
+      source:play()
+
+      local output = lovr.data.newSound(1000, 'f32', 'stereo', rate)
+      expect(lovr.audio.render(output)).to.be(1000)
+      expect(math.abs(output:getFrames(1, 500)[1] - .5) < .001).to.be(true)
+      expect(source:tell('frames') >= 1000).to.be(true)
+
+      source:seek(100, 'frames')
+      expect(source:tell('frames')).to.equal(100)
+      lovr.audio.render(output)
+      expect(source:tell('frames') >= 1100).to.be(true)
+
+      source:stop()
+      expect(source:tell('frames')).to.equal(0)
+    end)
+
+    test('virtual voices', function()
+      local rate = lovr.audio.getSampleRate()
+      local input = lovr.data.newSound(rate, 'f32', 'mono', rate)
+      local samples = {}
+      for i = 1, rate do samples[i] = .001 end
+      input:setFrames(samples)
+
+      -- The 64 loudest sources get mixed, the quieter ones are virtualized
+      local sources = {}
+      for i = 1, 200 do
+        sources[i] = lovr.audio.newSource(input, { spatial = false, pitchable = false })
+        sources[i]:setVolume(i <= 64 and 1 or .5)
+        expect(sources[i]:play()).to.be(true)
+      end
+
+      local output = lovr.data.newSound(rate / 10, 'f32', 'stereo', rate)
+      expect(lovr.audio.render(output)).to.be(rate / 10)
+      expect(math.abs(output:getFrames(1, rate / 10 - 1)[1] - .064) < .0001).to.be(true)
+
+      local active, virtual = lovr.audio.getVoiceCount()
+      expect(active).to.equal(64)
+      expect(virtual).to.equal(136)
+
+      for i = 1, 200 do
+        expect(sources[i]:isPlaying()).to.be(true)
+        expect(sources[i]:tell('frames') > 0).to.be(true)
+        sources[i]:stop()
+      end
+    end)
+
+    test('capacity', function()
+      local rate = lovr.audio.getSampleRate()
+      local input = lovr.data.newSound(rate, 'f32', 'mono', rate)
+      local output = lovr.data.newSound(256, 'f32', 'stereo', rate)
+      lovr.audio.render(output) -- Removes stopped sources
+
+      local sources = {}
+      for i = 1, 256 do
+        sources[i] = lovr.audio.newSource(input, { spatial = false, pitchable = false })
+        expect(sources[i]:play()).to.be(true)
+      end
+
+      local extra = lovr.audio.newSource(input, { spatial = false, pitchable = false })
+      expect(extra:play()).to.be(false)
+      expect(extra:isPlaying()).to.be(false)
+      expect(sources[1]:play()).to.be(true)
+
+      -- The slot is released once the mixer removes the stopped source
+      sources[1]:stop()
+      expect(extra:play()).to.be(false)
+      lovr.audio.render(output)
+      expect(extra:play()).to.be(true)
+
+      lovr.audio.render(output)
+      expect(extra:isPlaying()).to.be(true)
+      expect(extra:tell('frames') > 0).to.be(true)
+
+      extra:stop()
+      for i = 2, 256 do sources[i]:stop() end
+    end)
+
+    test('streams', function()
+      local rate = lovr.audio.getSampleRate()
+      local samples = {}
+      for i = 1, 256 do samples[i] = .01 end
+      local output = lovr.data.newSound(256, 'f32', 'stereo', rate)
+      lovr.audio.render(output) -- Removes stopped sources
+
+      -- Streams are never virtualized, even when there are more than MAX_VOICES of them
+      local streams, sources = {}, {}
+      for i = 1, 80 do
+        streams[i] = lovr.data.newSound(256, 'f32', 'mono', rate, 'stream')
+        streams[i]:setFrames(samples)
+        sources[i] = lovr.audio.newSource(streams[i], { spatial = false, pitchable = false })
+        expect(sources[i]:play()).to.be(true)
+      end
+
+      lovr.audio.render(output)
+      expect(math.abs(output:getFrames(1, 255)[1] - .8) < .001).to.be(true)
+
+      for i = 1, 80 do
+        expect(streams[i]:getFrameCount()).to.equal(0)
+        sources[i]:stop()
+      end
+    end)
+  end)
+end)
@@ -0,0 +1,350 @@
+-- Benchmarks, not run with the other tests.  Run them with `lovr test bench`.
+
+local function measure(fn)
+  fn() -- Warm up
+  local start = lovr.timer.getTime()
+  local runs = 0
+  repeat
+    fn()
+    runs = runs + 1
+  until lovr.timer.getTime() - start > .5
+  return (lovr.timer.getTime() - start) / runs
+end
+
+local function report(name, seconds, extra)
+  print(('%-24s %10.3f ms%s'):format(name, seconds * 1000, extra or ''))
+end
+
+group('bench', function()
+  test('thread', function()
+    local size = 65536
+    local chunks = 16
+    local image = lovr.data.newImage(size, 1, 'r32f')
+
+    local code = [[
+      require('lovr.data')
+      local first, last, image = ...
+      for i = first, last do
+        local x = i
+        for j = 1, 16 do x = math.sin(x) + j end
+        image:setPixel(i - 1, 0, x)
+      end
+    ]]
+
+    local work = load(code)
+
+    local serial = measure(function()
+      work(1, size, image)
+    end)
+
+    local parallel = measure(function()
+      lovr.thread.parallelFor(code, size, image)
+    end)
+
+    -- Fixed-size chunks, each one a separate job, like starting one job per chunk of work
+    local perJob = measure(function()
+      lovr.thread.parallelFor(code, { count = size, grain = size / chunks }, image)
+    end)
+
+    -- One Thread per chunk, the way this had to be done before parallelFor
+    local threads = {}
+    for i = 1, chunks do
+      threads[i] = lovr.thread.newThread(code)
+    end
+
+    local perThread = measure(function()
+      local chunk = size / chunks
+      for i = 1, chunks do
+        threads[i]:start((i - 1) * chunk + 1, i * chunk, image)
+      end
+      for i = 1, chunks do
+        threads[i]:wait()
+      end
+    end)
+
+    report('serial', serial)
+    report('parallelFor', parallel, (' (%.2fx)'):format(serial / parallel))
+    report('job per chunk', perJob, (' (%.2fx)'):format(serial / perJob))
+    report('Thread per chunk', perThread, (' (%.2fx)'):format(serial / perThread))
+
+    expect(image:getPixel(size - 1, 0)).to.be.a('number')
+  end)
+
+  test('audio commands', function()
+    lovr.audio.stop()
+
+    local rate = lovr.audio.getSampleRate()
+    local input = lovr.data.newSound(rate, 'f32', 'mono', rate)
+    local source = lovr.audio.newSource(input, { spatial = false })
+
+    -- Without a running device, commands are applied on the calling thread as they're sent
+    local pitch = measure(function()
+      for i = 1, 1000 do
+        source:setPitch(1 + i % 2 * .5)
+      end
+    end)
+
+    local play = measure(function()
+      for i = 1, 1000 do
+        source:play()
+        source:pause()
+      end
+    end)
+
+    report('1000 setPitch', pitch)
+    report('1000 play/pause', play)
+
+    source:stop()
+    expect(source:getPitch()).to.equal(1)
+  end)
+
+  test('audio', function()
+    lovr.audio.stop()
+
+    local rate = lovr.audio.getSampleRate()
+    local seconds = 1
+    local input = lovr.data.newSound(rate, 'f32', 'mono', rate)
+    local samples = {}
+    for i = 1, rate do samples[i] = .001 end
+    input:setFrames(samples)
+
+    local output = lovr.data.newSound(rate * seconds, 'f32', 'stereo', rate)
+    local flush = lovr.data.newSound(256, 'f32', 'stereo', rate)
+
+    for _, count in ipairs({ 16, 64, 256 }) do
+      local sources = {}
+      for i = 1, count do
+        sources[i] = lovr.audio.newSource(input, { spatial = false, pitchable = false })
+        sources[i]:setLooping(true)
+        sources[i]:play()
+      end
+
+      local duration = measure(function()
+        lovr.audio.render(output)
+      end)
+
+      local active, virtual = lovr.audio.getVoiceCount()
+      report(('%d sources'):format(count), duration, (' (%d frames/s, %d active, %d virtual)'):format(math.floor(rate * seconds / duration), active, virtual))
+
+      expect(active).to.equal(math.min(count, 64))
+      expect(virtual).to.equal(count - active)
+      expect(math.abs(output:getFrames(1, rate * seconds - 1)[1] - active * .001) < .0001).to.be(true)
+
+      for i = 1, count do
+        sources[i]:stop()
+      end
+
+      lovr.audio.render(flush) -- Removes the stopped sources
+    end
+  end)
+
+  test('physics', function()
+    local function stress(threads)
+      local world = lovr.physics.newWorld({ threads = threads })
+      world:newBoxCollider(0, -.5, 0, 100, 1, 100):setKinematic(true)
+
+      -- 1000 boxes in stacks of 10
+      for x = 1, 10 do
+        for z = 1, 10 do
+          for y = 1, 10 do
+            world:newBoxCollider(x * 1.5 - 8, y - .5, z * 1.5 - 8, 1, 1, 1)
+          end
+        end
+      end
+
+      -- 50 ragdolls, as chains of capsules held together by ball joints
+      for i = 1, 50 do
+        local x, z = (i % 10) * 2 - 10, math.floor(i / 10) * 2 + 10
+        local last
+        for j = 1, 6 do
+          local part = world:newCapsuleCollider(x, 2 + j * .5, z, .1, .3)
+          if last then lovr.physics.newBallJoint(last, part, x, 1.75 + j * .5, z) end
+          last = part
+        end
+      end
+
+      local steps = 120
+      local start = lovr.timer.getTime()
+      for i = 1, steps do
+        world:update(1 / 60)
+      end
+      local duration = (lovr.timer.getTime() - start) / steps
+
+      world:destroy()
+      return duration
+    end
+
+    -- Worlds use at most one thread per worker plus the calling thread
+    local serial = stress(1)
+    report('1 thread', serial, ' per step')
+    for _, threads in ipairs({ 2, 4, 8 }) do
+      local duration = stress(threads)
+      report(('%d threads'):format(threads), duration, (' per step (%.2fx)'):format(serial / duration))
+    end
+  end)
+
+  test('batching', function()
+    local texture = lovr.graphics.newTexture(64, 64)
+    local pass = lovr.graphics.newPass(texture)
+
+    local function record(batching)
+      pass:reset()
+      pass:setBatching(batching)
+      for i = 0, 9999 do
+        pass:box(i % 100 - 50, math.floor(i / 100) - 50, -100, .5)
+      end
+      lovr.graphics.submit(pass)
+      lovr.graphics.wait()
+    end
+
+    local unbatched = measure(function() record(false) end)
+    local stats = pass:getStats()
+    report('10000 boxes', unbatched, (' (%d draws, %d draw calls)'):format(stats.draws, stats.drawCalls))
+
+    local batched = measure(function() record(true) end)
+    stats = pass:getStats()
+    report('10000 boxes, batched', batched, (' (%d draws, %d draw calls, %.2fx)'):format(stats.draws, stats.drawCalls, unbatched / batched))
+
+    expect(stats.drawCalls < stats.draws).to.be(true)
+  end)
+
+  test('model images', function()
+    local alphabet = 'ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/'
+    local function base64(s)
+      local out = {}
+      for i = 1, #s, 3 do
+        local a, b, c = s:byte(i, i + 2)
+        local x = a * 65536 + (b or 0) * 256 + (c or 0)
+        local i1 = math.floor(x / 262144) % 64 + 1
+        local i2 = math.floor(x / 4096) % 64 + 1
+        local i3 = math.floor(x / 64) % 64 + 1
+        local i4 = x % 64 + 1
+        out[#out + 1] = alphabet:sub(i1, i1) .. alphabet:sub(i2, i2) ..
+          (b and alphabet:sub(i3, i3) or '=') .. (c and alphabet:sub(i4, i4) or '=')
+      end
+      return table.concat(out)
+    end
+
+    -- A glTF with 16 materials, each with its own 512x512 PNG
+    local count, size = 16, 512
+    local pngs, images, textures, materials = {}, {}, {}, {}
+    for i = 1, count do
+      local image = lovr.data.newImage(size, size)
+      image:mapPixel(function(x, y)
+        return (x * x + y * y * i) % 256 / 255, x * y % 256 / 255, i / count, 1
+      end)
+      pngs[i] = image:encode()
+      images[i] = ('{ "uri": "data:image/png;base64,%s" }'):format(base64(pngs[i]:getString()))
+      textures[i] = ('{ "source": %d }'):format(i - 1)
+      materials[i] = ('{ "pbrMetallicRoughness": { "baseColorTexture": { "index": %d } } }'):format(i - 1)
+    end
+
+    local gltf = lovr.data.newBlob(([[{
+      "asset": { "version": "2.0" },
+      "images": [%s],
+      "textures": [%s],
+      "materials": [%s]
+    }]]):format(table.concat(images, ','), table.concat(textures, ','), table.concat(materials, ',')), 'images.gltf')
+
+    -- Decoding the same PNGs one after another, the way models loaded them before
+    local serial = measure(function()
+      for i = 1, count do
+        lovr.data.newImage(pngs[i])
+      end
+    end)
+
+    local parallel = measure(function()
+      lovr.data.newModelData(gltf)
+    end)
+
+    -- The number of workers comes from t.thread.workers, so compare thread counts across runs
+    report(('%d images, serial'):format(count), serial)
+    report(('%d images, model'):format(count), parallel, (' (%.2fx)'):format(serial / parallel))
+
+    expect(lovr.data.newModelData(gltf):getImageCount()).to.equal(count)
+  end)
+
+  test('mocap', function()
+    local ok, ffi = pcall(require, 'ffi')
+    if not ok then return end
+
+    -- A mocap-sized clip: a chain of 64 joints with rotation and translation keys at 30 fps for
+    -- about a minute, stored in a separate .bin like exported clips usually are
+    local joints, keys = 64, 2000
+    local size = keys * 4 + joints * keys * 28
+    local buffer = lovr.data.newBlob(size)
+    local floats = ffi.cast('float*', buffer:getPointer())
+
+    for k = 0, keys - 1 do
+      floats[k] = k / 30
+    end
+
+    local cursor = keys
+    local views, accessors, channels, samplers, nodes = {}, {}, {}, {}, {}
+    table.insert(views, ('{ "buffer": 0, "byteLength": %d }'):format(keys * 4))
+    table.insert(accessors, ('{ "bufferView": 0, "componentType": 5126, "count": %d, "type": "SCALAR", "min": [0], "max": [%f] }'):format(keys, (keys - 1) / 30))
+
+    for j = 0, joints - 1 do
+      local rotation, translation = cursor, cursor + keys * 4
+      for k = 0, keys - 1 do
+        local angle = math.sin(k * .05 + j) * .5
+        floats[rotation + k * 4 + 0] = 0
+        floats[rotation + k * 4 + 1] = 0
+        floats[rotation + k * 4 + 2] = math.sin(angle / 2)
+        floats[rotation + k * 4 + 3] = math.cos(angle / 2)
+        floats[translation + k * 3 + 0] = math.sin(k * .01) * .1
+        floats[translation + k * 3 + 1] = .1
+        floats[translation + k * 3 + 2] = 0
+      end
+
+      table.insert(views, ('{ "buffer": 0, "byteOffset": %d, "byteLength": %d }'):format(rotation * 4, keys * 16))
+      table.insert(views, ('{ "buffer": 0, "byteOffset": %d, "byteLength": %d }'):format(translation * 4, keys * 12))
+      table.insert(accessors, ('{ "bufferView": %d, "componentType": 5126, "count": %d, "type": "VEC4" }'):format(#views - 2, keys))
+      table.insert(accessors, ('{ "bufferView": %d, "componentType": 5126, "count": %d, "type": "VEC3" }'):format(#views - 1, keys))
+      table.insert(samplers, ('{ "input": 0, "output": %d }'):format(#accessors - 2))
+      table.insert(samplers, ('{ "input": 0, "output": %d }'):format(#accessors - 1))
+      table.insert(channels, ('{ "sampler": %d, "target": { "node": %d, "path": "rotation" } }'):format(#samplers - 2, j))
+      table.insert(channels, ('{ "sampler": %d, "target": { "node": %d, "path": "translation" } }'):format(#samplers - 1, j))
+      table.insert(nodes, j < joints - 1 and ('{ "children": [%d] }'):format(j + 1) or '{}')
+      cursor = translation + keys * 3
+    end
+
+    assert(lovr.filesystem.write('mocap.bin', buffer))
+
+    local gltf = lovr.data.newBlob(([[{
+      "asset": { "version": "2.0" },
+      "buffers": [{ "byteLength": %d, "uri": "mocap.bin" }],
+      "bufferViews": [%s],
+      "accessors": [%s],
+      "animations": [{ "channels": [%s], "samplers": [%s] }],
+      "nodes": [%s],
+      "scenes": [{ "nodes": [0] }]
+    }]]):format(size, table.concat(views, ','), table.concat(accessors, ','), table.concat(channels, ','), table.concat(samplers, ','), table.concat(nodes, ',')), 'mocap.gltf')
+
+    local data = lovr.data.newModelData(gltf)
+    local duration = data:getAnimationDuration(1)
+
+    local models, times = {}, {}
+    for i = 1, 100 do
+      models[i] = lovr.graphics.newModel(data)
+      times[i] = (i * .37) % duration
+    end
+
+    local serial = measure(function()
+      for i = 1, #models do
+        models[i]:animate(1, times[i])
+      end
+    end)
+
+    local parallel = measure(function()
+      lovr.graphics.animateModels(models, 1, times)
+    end)
+
+    local channelCount = data:getAnimationChannelCount(1)
+    report(('%d models, %d channels'):format(#models, channelCount), serial, ' (Model:animate)')
+    report(('%d models, %d channels'):format(#models, channelCount), parallel, (' (animateModels, %.2fx)'):format(serial / parallel))
+
+    expect(channelCount).to.equal(joints * 2)
+    assert(lovr.filesystem.remove('mocap.bin'))
+  end)
+end)
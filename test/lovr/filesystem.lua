@@ -57,4 +57,167 @@ group('filesystem', function()
     assert(file:read(2) == 'hi')
     assert(file:tell() == 2)
   end)
+
+  test('newBlob', function()
+    assert(lovr.filesystem.write('blob.txt', 'hello'))
+    local blob = lovr.filesystem.newBlob('blob.txt')
+    expect(blob:getString()).to.equal('hello')
+
+    -- The file can be truncated and rewritten while a Blob of it is alive
+    assert(lovr.filesystem.write('blob.txt', 'hi'))
+    expect(blob:getString()).to.equal('hello')
+    expect(lovr.filesystem.read('blob.txt')).to.equal('hi')
+
+    -- Blobs are writable, writes don't reach the file
+    local ok, ffi = pcall(require, 'ffi')
+    if ok and ffi then
+      ffi.cast('uint8_t*', blob:getPointer())[0] = string.byte('j')
+      expect(blob:getString()).to.equal('jello')
+      expect(lovr.filesystem.read('blob.txt')).to.equal('hi')
+    end
+
+    blob = nil
+    collectgarbage()
+    assert(lovr.filesystem.remove('blob.txt'))
+  end)
+
+  local function u16(x) return string.char(x % 256, math.floor(x / 256) % 256) end
+  local function u32(x) return u16(x % 65536) .. u16(math.floor(x / 65536)) end
+
+  -- Mounts a zip holding a single deflated entry at seek/data.bin
+  local function mountZip(deflated, size)
+    local name = 'data.bin'
+    local header = u32(0x04034b50) .. u16(20) .. u16(0) .. u16(8) .. u32(0) .. u32(0) .. u32(#deflated) .. u32(size) .. u16(#name) .. u16(0) .. name
+    local central = u32(0x02014b50) .. u16(20) .. u16(20) .. u16(0) .. u16(8) .. u32(0) .. u32(0) .. u32(#deflated) .. u32(size) .. u16(#name) .. u16(0) .. u16(0) .. u16(0) .. u16(0) .. u32(0) .. u32(0) .. name
+    local footer = u32(0x06054b50) .. u16(0) .. u16(0) .. u16(1) .. u16(1) .. u32(#central) .. u32(#header + #deflated) .. u16(0)
+    assert(lovr.filesystem.write('seek.zip', header .. deflated .. central .. footer))
+    assert(lovr.filesystem.mount(lovr.filesystem.getSaveDirectory() .. '/seek.zip', 'seek'))
+  end
+
+  local function unmountZip()
+    assert(lovr.filesystem.unmount(lovr.filesystem.getSaveDirectory() .. '/seek.zip'))
+    assert(lovr.filesystem.remove('seek.zip'))
+  end
+
+  test('zip seek', function()
+    -- 3MB entry where every 4 bytes hold their own index, deflated using stored blocks
+    local size = 3 * 1024 * 1024
+    local blocks = {}
+    for start = 0, size - 1, 65532 do
+      local words = {}
+      for i = start / 4, math.min(start + 65532, size) / 4 - 1 do
+        words[#words + 1] = u32(i)
+      end
+      local block = table.concat(words)
+      local final = start + 65532 >= size and 1 or 0
+      blocks[#blocks + 1] = string.char(final) .. u16(#block) .. u16(65535 - #block) .. block
+    end
+    mountZip(table.concat(blocks), size)
+
+    local file = lovr.filesystem.newFile('seek/data.bin', 'r')
+    expect(file:getSize()).to.equal(size)
+
+    local function check(offset, count)
+      assert(file:seek(offset))
+      local data = file:read(count)
+      expect(#data).to.equal(count)
+      for i = 0, count - 4, 4092 do
+        local a, b, c, d = data:byte(i + 1, i + 4)
+        expect(a + b * 256 + c * 65536 + d * 16777216).to.equal((offset + i) / 4)
+      end
+    end
+
+    check(2500000, 100000) -- forwards
+    check(100, 8) -- backwards to the beginning
+    check(2900000, 16) -- forwards, recording checkpoints
+    check(1500000, 100000) -- backwards to a checkpoint
+    check(2200000, 16) -- forwards past a checkpoint
+    check(size - 4, 4)
+    check(0, 65536)
+
+    file:release()
+    unmountZip()
+  end)
+
+  test('zip seek compressed', function()
+    -- 3MB entry made of 256 byte records: an 8 byte hex index followed by 248 bytes that repeat
+    -- every 125 records. After the first 125 records, each tail is a back-reference 32000 bytes
+    -- back, so decoding past a checkpoint depends on its restored window.
+    local size = 3 * 1024 * 1024
+    local period, distance = 125, 32000
+    local tails, records = {}, {}
+    for j = 0, period - 1 do
+      local tail = {}
+      for k = 0, 247 do
+        tail[k + 1] = string.char(65 + (j * 7 + k * 13 + math.floor(k / 5)) % 26)
+      end
+      tails[j] = table.concat(tail)
+    end
+    for i = 0, size / 256 - 1 do
+      records[i + 1] = string.format('%08x', i) .. tails[i % period]
+    end
+    local contents = table.concat(records)
+
+    -- Fixed Huffman deflate encoder
+    local out, acc, bits = {}, 0, 0
+    local function put(value, count) -- LSB first
+      acc = acc + value * 2 ^ bits
+      bits = bits + count
+      while bits >= 8 do
+        out[#out + 1] = string.char(acc % 256)
+        acc = math.floor(acc / 256)
+        bits = bits - 8
+      end
+    end
+    local function code(value, count) -- MSB first
+      for k = count - 1, 0, -1 do
+        put(math.floor(value / 2 ^ k) % 2, 1)
+      end
+    end
+    local function literal(byte)
+      if byte < 144 then code(0x30 + byte, 8) else code(0x190 + byte - 144, 9) end
+    end
+
+    put(1, 1) -- final
+    put(1, 2) -- fixed Huffman
+    for i = 1, #records do
+      local record = records[i]
+      local last = i <= period and 256 or 8
+      for k = 1, last do
+        literal(record:byte(k))
+      end
+      if last == 8 then
+        code(0xc0 + 284 - 280, 8) -- length 227-257
+        put(248 - 227, 5)
+        code(29, 5) -- distance 24577-32768
+        put(distance - 24577, 13)
+      end
+    end
+    code(0, 7) -- end of block
+    put(0, 7)
+    mountZip(table.concat(out), size)
+
+    local file = lovr.filesystem.newFile('seek/data.bin', 'r')
+    expect(file:getSize()).to.equal(size)
+
+    local function check(offset, count)
+      assert(file:seek(offset))
+      local data = file:read(count)
+      expect(#data).to.equal(count)
+      expect(data == contents:sub(offset + 1, offset + count)).to.be(true)
+    end
+
+    check(2900000, 4096) -- forwards
+    check(10, 100) -- backwards to the beginning
+    check(3000000, 100000) -- forwards, recording checkpoints
+    check(1100000, 4096) -- backwards to the first checkpoint
+    check(2150000, 65536) -- forwards past the second checkpoint
+    check(1048000, 2000) -- backwards, straddling the first checkpoint
+    check(2097000, 100000) -- forwards, straddling the second checkpoint
+    check(512, 1024) -- backwards to the beginning again
+    check(size - 256, 256)
+
+    file:release()
+    unmountZip()
+  end)
 end)
@@ -354,6 +354,209 @@ group('graphics', function()
       local lines = font:getLines({ 0xff0000, 'hello ', 0x0000ff, 'world' }, 0)
       expect(lines).to.equal({ 'hello ', 'world' })
     end)
+
+    test(':setAtlasCache', function()
+      local font = lovr.graphics.newFont(lovr.data.newRasterizer(20))
+      font:preload('hello world', 0x263a)
+      local cache = font:getAtlasCache()
+      local cached = lovr.graphics.newFont(lovr.data.newRasterizer(20))
+      expect(cached:setAtlasCache(cache)).to.be(true)
+
+      -- Glyph positions and UVs match the font that made the cache, and a fresh font packing the same glyphs
+      local fresh = lovr.graphics.newFont(lovr.data.newRasterizer(20))
+      fresh:preload('hello world', 0x263a)
+      local vertices = font:getVertices('hello world')
+      expect(#vertices).to.be(40)
+      expect(cached:getVertices('hello world')).to.equal(vertices)
+      expect(fresh:getVertices('hello world')).to.equal(vertices)
+
+      expect(lovr.graphics.newFont(lovr.data.newRasterizer(30)):setAtlasCache(cache)).to.be(false)
+
+      -- The first glyph's page index (after the 32 byte header and 12 bytes into the glyph)
+      local data = cache:getString()
+      local corrupt = lovr.data.newBlob(data:sub(1, 44) .. '\255\255' .. data:sub(47))
+      expect(lovr.graphics.newFont(lovr.data.newRasterizer(20)):setAtlasCache(corrupt)).to.be(false)
+    end)
+
+    test(':getVertices', function()
+      local font = lovr.graphics.newFont(lovr.data.newRasterizer(20))
+      local vertices, material, batches = font:getVertices('hi')
+      expect(#vertices).to.be(8)
+      expect(#vertices[1]).to.be(4)
+      expect(type(material)).to.be('userdata')
+      expect(batches).to.equal({ { material = material, start = 1, count = 8 } })
+
+      -- A huge spread makes every glyph take up a quarter of an atlas page
+      font = lovr.graphics.newFont(32, 400)
+      vertices, material, batches = font:getVertices('ABCDE')
+      expect(#vertices).to.be(20)
+      expect(#batches).to.be(2)
+      expect(batches[1]).to.equal({ material = material, start = 1, count = 16 })
+      expect(batches[2].start).to.be(17)
+      expect(batches[2].count).to.be(4)
+      expect(batches[2].material).to_not.be(material)
+      local first, second = material, batches[2].material
+
+      -- Fill all of the pages, pages used this frame can't be evicted
+      local chars = {}
+      for c = 33, 96 do chars[#chars + 1] = string.char(c) end
+      font:getVertices(table.concat(chars))
+      local ok, err = pcall(font.getVertices, font, 'a')
+      expect(ok).to.be(false)
+      expect(err).to.match('Font atlas is full')
+
+      -- Next frame, the least recently used page (the first one) is evicted and reused
+      lovr.graphics.submit()
+      vertices, material, batches = font:getVertices('a')
+      expect(#batches).to.be(1)
+      expect(material).to.be(first)
+      vertices, material, batches = font:getVertices('AE')
+      expect(#batches).to.be(2)
+      expect(batches[1].material).to.be(first)
+      expect(batches[2].material).to.be(second)
+    end)
+  end)
+
+  group('Shader', function()
+    test('SPIR-V cache', function()
+      local source = ('void lovrmain() { } // %d\n'):format(math.random(2 ^ 30))
+      local size = lovr.graphics.getSpirvCache():getSize()
+      local a = lovr.graphics.compileShader(source)
+      expect(lovr.graphics.getSpirvCache():getSize() > size).to.be(true)
+      size = lovr.graphics.getSpirvCache():getSize()
+      local b = lovr.graphics.compileShader(source)
+      expect(lovr.graphics.getSpirvCache():getSize()).to.be(size)
+      expect(b:getString()).to.be(a:getString())
+    end)
+
+    test('async', function()
+      local shader = lovr.graphics.newShader('unlit', 'unlit', { async = true })
+      expect(shader:hasAttribute('VertexPosition')).to.be(true)
+      expect(shader:isComplete()).to.be(true)
+
+      local texture = lovr.graphics.newTexture(1, 1)
+      local pass = lovr.graphics.newPass(texture)
+      pass:setShader(shader)
+      pass:sphere()
+      lovr.graphics.prewarm(pass)
+      lovr.graphics.submit(pass)
+      expect(pass:getStats().pipelinesCreated).to.equal(0)
+      expect(lovr.graphics.isPrewarming()).to.be(false)
+
+      -- Shader can be released while its pipeline is still being created
+      shader = lovr.graphics.newShader('unlit', 'unlit', { async = true })
+      pass:reset()
+      pass:setShader(shader)
+      pass:cube()
+      lovr.graphics.prewarm(pass)
+      pass:reset()
+      shader = nil
+      collectgarbage()
+      collectgarbage()
+      while lovr.graphics.isPrewarming() do lovr.timer.sleep(.001) end
+      lovr.graphics.submit()
+    end)
+  end)
+
+  group('Model', function()
+    test('async', function()
+      local blob = lovr.data.newBlob('v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n', 'triangle.obj')
+      local model = lovr.graphics.newModel(blob, { async = true })
+      local texture = lovr.graphics.newTexture(1, 1)
+      local pass = lovr.graphics.newPass(texture)
+      pass:draw(model)
+      expect(model:getNodeCount() > 0).to.be(true)
+      expect(model:isComplete()).to.be(true)
+      pass:draw(model)
+      lovr.graphics.submit(pass)
+
+      -- Line loops fail after the data is decoded, the error sticks instead of leaving a broken Model
+      local gltf = [[{
+        "asset": { "version": "2.0" },
+        "buffers": [{ "byteLength": 36, "uri": "data:application/octet-stream;base64,]] .. ('A'):rep(48) .. [[" }],
+        "bufferViews": [{ "buffer": 0, "byteLength": 36 }],
+        "accessors": [{ "bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3" }],
+        "meshes": [{ "primitives": [{ "attributes": { "POSITION": 0 }, "mode": 2 }] }],
+        "nodes": [{ "mesh": 0 }],
+        "scenes": [{ "nodes": [0] }]
+      }]]
+      model = lovr.graphics.newModel(lovr.data.newBlob(gltf, 'loop.gltf'), { async = true })
+      expect(function() model:getNodeCount() end).to.fail()
+      expect(function() model:getNodeCount() end).to.fail()
+      expect(function() pass:draw(model) end).to.fail()
+    end)
+
+    -- One cubic spline translation channel with keyframes at t=0 and t=2, stored as
+    -- (in tangent, value, out tangent) triples:
+    --   0: (0, 0, 0), (0, 2, 0), (1, 0, 0)
+    --   2: (-1, 0, 0), (4, 0, 1), (0, 0, 0)
+    local spline = [[{
+      "asset": { "version": "2.0" },
+      "buffers": [{ "byteLength": 80, "uri": "data:application/octet-stream;base64,AAAAAAAAAEAAAAAAAAAAAAAAAAAAAAAAAAAAQAAAAAAAAIA/AAAAAAAAAAAAAIC/AAAAAAAAAAAAAIBAAAAAAAAAgD8AAAAAAAAAAAAAAAA=" }],
+      "bufferViews": [{ "buffer": 0, "byteLength": 8 }, { "buffer": 0, "byteOffset": 8, "byteLength": 72 }],
+      "accessors": [
+        { "bufferView": 0, "componentType": 5126, "count": 2, "type": "SCALAR" },
+        { "bufferView": 1, "componentType": 5126, "count": 6, "type": "VEC3" }
+      ],
+      "animations": [{
+        "samplers": [{ "input": 0, "output": 1, "interpolation": "CUBICSPLINE" }],
+        "channels": [{ "sampler": 0, "target": { "node": 0, "path": "translation" } }]
+      }],
+      "nodes": [{ "name": "node" }],
+      "scenes": [{ "nodes": [0] }]
+    }]]
+
+    test(':animate', function()
+      local model = lovr.graphics.newModel(lovr.data.newBlob(spline, 'spline.gltf'))
+
+      -- At t=.5, s=.25 and dt=2, so the Hermite basis is (.84375, .140625, .15625, -.046875) and the
+      -- tangent terms get scaled by dt
+      model:animate(1, .5)
+      local x, y, z = model:getNodePosition('node', 'parent')
+      expect(math.abs(x - (.140625 * 2 * 1 + .15625 * 4 + -.046875 * 2 * -1)) < 1e-6).to.be(true)
+      expect(math.abs(y - .84375 * 2) < 1e-6).to.be(true)
+      expect(math.abs(z - .15625 * 1) < 1e-6).to.be(true)
+
+      -- Keyframes themselves use the middle value of the triple
+      model:animate(1, 0)
+      expect({ model:getNodePosition('node', 'parent') }).to.equal({ 0, 2, 0 })
+    end)
+
+    test(':setPose', function()
+      local blob = lovr.data.newBlob('v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n', 'triangle.obj')
+      local model = lovr.graphics.newModel(blob)
+      local pose = lovr.graphics.newPose(model)
+      local other = lovr.graphics.newPose(model)
+      model:setNodePosition(1, 2, 0, 0)
+      model:getPose(other)
+      pose:blend(other, .5, { 1 })
+      pose:add(other, 1)
+      model:setPose(pose)
+      expect({ model:getNodePosition(1, 'parent') }).to.equal({ 3, 0, 0 })
+
+      -- Poses can be sampled on another thread and applied on this one
+      model = lovr.graphics.newModel(lovr.data.newBlob(spline, 'spline.gltf'))
+      local channel = lovr.thread.getChannel('pose')
+      local thread = lovr.thread.newThread([[
+        require('lovr.graphics')
+        require('lovr.thread')
+        local data, channel = ...
+        local pose = lovr.graphics.newPose(data)
+        pose:sample(1, 0)
+        channel:push(pose)
+      ]])
+      thread:start(model:getData(), channel)
+      thread:wait()
+      expect(thread:getError()).to.equal(nil)
+      model:setPose(channel:pop())
+      expect({ model:getNodePosition('node', 'parent') }).to.equal({ 0, 2, 0 })
+
+      -- ModelData without any nodes
+      local empty = lovr.data.newModelData(lovr.data.newBlob('{ "asset": { "version": "2.0" } }', 'empty.gltf'))
+      pose = lovr.graphics.newPose(empty)
+      pose:reset()
+      expect(pose:getModelData():getNodeCount()).to.equal(0)
+    end)
   end)
 
   group('Pass', function()
@@ -381,6 +584,29 @@ group('graphics', function()
       lovr.graphics.submit(pass)
     end)
 
+    test(':setViewCull', function()
+      -- Default projection is infinite reverse-Z, so one of the frustum planes is degenerate
+      pass = lovr.graphics.newPass(lovr.graphics.newTexture(1, 1))
+      pass:setViewCull(true)
+      pass:sphere(0, 0, -10)
+      pass:sphere(0, 0, 10)
+      pass:sphere(0, 0, -1e6)
+      lovr.graphics.submit(pass)
+      expect(pass:getStats().draws).to.equal(3)
+      expect(pass:getStats().drawsCulled).to.equal(1)
+    end)
+
+    test(':text cache', function()
+      local label = ('label %d'):format(math.random(2 ^ 30))
+      pass = lovr.graphics.newPass(lovr.graphics.newTexture(1, 1))
+      pass:text(label)
+      pass:text(label)
+      pass:text(label)
+      expect(pass:getStats().textCacheHits).to.equal(1)
+      expect(pass:getStats().textCacheMisses).to.equal(2)
+      lovr.graphics.submit(pass)
+    end)
+
     test(':send', function()
       -- First draw has uniforms, second draw does not, and first draw is culled
       shader1 = lovr.graphics.newShader('unlit', [[
@@ -8,5 +8,102 @@ group('physics', function()
       local c2 = world:newBoxCollider(1e8, 0, 0)
       world:update(1)
     end)
+
+    test('threads', function()
+      local function simulate(threads)
+        local world = lovr.physics.newWorld({ threads = threads })
+        world:newBoxCollider(0, -.5, 0, 20, 1, 20):setKinematic(true)
+        local boxes = {}
+        for i = 1, 50 do
+          boxes[i] = world:newBoxCollider((i % 5) * 1.5, i, 0, 1, 1, 1)
+        end
+        for i = 1, 60 do
+          world:update(1 / 60)
+        end
+        local heights = {}
+        for i = 1, #boxes do
+          heights[i] = select(2, boxes[i]:getPosition())
+        end
+        world:destroy()
+        return heights
+      end
+
+      local serial = simulate(1)
+      local parallel = simulate()
+      for i = 1, #serial do
+        expect(math.abs(parallel[i] - serial[i]) < 1e-4).to.be(true)
+      end
+    end)
+
+    test('poses', function()
+      local a = world:newBoxCollider(1, 2, 3)
+      local b = world:newSphereCollider(-1, -2, -3)
+      world:setPoses({ a, b }, { 4, 5, 6, 0, 0, 0, 1, 7, 8, 9, 0, 0, 0, 1 })
+      expect({ a:getPosition() }).to.equal({ 4, 5, 6 })
+      expect({ b:getPosition() }).to.equal({ 7, 8, 9 })
+
+      local blob = lovr.data.newBlob(2 * 7 * 4)
+      world:getPoses({ b, a }, blob)
+      local poses = world:getPoses({ b, a })
+      expect(#poses).to.equal(14)
+      expect(poses[1]).to.equal(7)
+      expect(poses[8]).to.equal(4)
+      world:setPoses({ a, b }, blob)
+      expect({ a:getPosition() }).to.equal({ 7, 8, 9 })
+    end)
+
+    test('snapshots', function()
+      local world = lovr.physics.newWorld({ snapshots = true })
+      local box = world:newBoxCollider(0, 1, 0)
+      world:update(1 / 60)
+      local colliders, transforms = world:getSnapshot()
+      expect(#colliders).to.equal(1)
+      expect(colliders[1]).to.equal(box)
+      expect(transforms:getSize()).to.equal(64)
+
+      -- Destroying a collider leaves the snapshots alone, and it's dropped from later ones
+      box:destroy()
+      colliders = world:getSnapshot()
+      expect(colliders[1]).to.equal(box)
+      expect(box:isDestroyed()).to.be(true)
+      world:update(1 / 60)
+      colliders = world:getSnapshot()
+      expect(#colliders).to.equal(0)
+      world:destroy()
+    end)
+
+    test('raycastBatch', function()
+      local box = world:newBoxCollider(0, 0, 0, 2)
+      local results, colliders, shapes = world:raycastBatch({
+        -5, 0, 0, 5, 0, 0,
+        -5, 5, 0, 5, 5, 0
+      })
+      expect(colliders[1]).to.equal(box)
+      expect(colliders[2]).to.equal(false)
+      expect(shapes[1]).to.equal(box:getShape())
+      expect(shapes[2]).to.equal(false)
+      expect(results:getSize()).to.equal(2 * 7 * 4)
+      expect(math.abs(results:getF32(0) + 1) < 1e-3).to.be(true)
+      expect(math.abs(results:getF32(24) - .4) < 1e-3).to.be(true)
+      expect(function() world:raycastBatch({ -5, 0, 0, 5, 0, 'x' }) end).to.fail()
+    end)
+
+    test('trigger events', function()
+      local sensor = world:newBoxCollider(0, 0, 0, 2)
+      sensor:setSensor(true)
+      sensor:setKinematic(true)
+      local ball = world:newSphereCollider(0, 0, 0, .5)
+      ball:setGravityScale(0)
+      ball:setLinearVelocity(0, 60, 0)
+      world:update(1 / 60)
+      local enters, exits = world:getTriggerEvents()
+      expect(enters).to.equal({ sensor, ball })
+      expect(#exits).to.equal(0)
+      world:update(1 / 60)
+      world:update(1 / 60)
+      enters, exits = world:getTriggerEvents()
+      expect(#enters).to.equal(0)
+      expect(exits).to.equal({ sensor, ball })
+    end)
   end)
 end)
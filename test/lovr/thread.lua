@@ -10,4 +10,38 @@ group('thread', function()
       thread:wait()
     end)
   end)
+
+  test('parallelFor', function()
+    local image = lovr.data.newImage(100, 1, 'r32f')
+
+    lovr.thread.parallelFor([[
+      require('lovr.data')
+      local first, last, image = ...
+      for i = first, last do
+        image:setPixel(i - 1, 0, i)
+      end
+    ]], 100, image)
+
+    for i = 1, 100 do
+      expect(image:getPixel(i - 1, 0)).to.equal(i)
+    end
+
+    lovr.thread.parallelFor([[
+      require('lovr.data')
+      local first, last, image = ...
+      image:setPixel(first - 1, 0, last - first + 1)
+    ]], { count = 100, grain = 1 }, image)
+
+    for i = 1, 100 do
+      expect(image:getPixel(i - 1, 0)).to.equal(1)
+    end
+
+    expect(function()
+      lovr.thread.parallelFor('\nerror("oops")', 10)
+    end).to.fail()
+
+    expect(function()
+      lovr.thread.parallelFor('\n', 10, 1, 2, 3, 4, 5)
+    end).to.fail()
+  end)
 end)